@@ -0,0 +1,127 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Assets/AssetManager.h"
+#include "BenchUtil.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// AssetStreamBench [files] [kilobytes per file]
+// Writes the files to a temporary directory, then streams them through an AssetManager
+// with 1, 2 and 4 I/O threads while a 1 ms "frame" calls Update(). One in a hundred loads is
+// Critical. Reports throughput, frames until everything arrived and the slowest Update().
+// The files are read back from the page cache after the first pass, so this measures the
+// manager's overhead more than the disk.
+
+using namespace Exodus;
+
+namespace
+{
+	std::string FilePath( const std::filesystem::path& directory, uint32_t index )
+	{
+		return (directory / ("asset" + std::to_string( index ) + ".bin")).string();
+	}
+
+	bool WriteFiles( const std::filesystem::path& directory, uint32_t fileCount, size_t fileSize )
+	{
+		std::filesystem::create_directories( directory );
+		std::vector<char> contents( fileSize );
+		for (uint32_t i = 0u; i < fileCount; ++i)
+		{
+			std::fill( contents.begin(), contents.end(), static_cast<char>(i) );
+			std::ofstream file( FilePath( directory, i ), std::ios::binary | std::ios::trunc );
+			file.write( contents.data(), static_cast<std::streamsize>(contents.size()) );
+			if (!file)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Stream( const std::filesystem::path& directory, uint32_t fileCount, uint32_t ioThreads )
+	{
+		AssetManager assets( ioThreads );
+		std::vector<AssetHandle> handles;
+		handles.reserve( fileCount );
+		uint32_t finished = 0u;
+		uint32_t failed = 0u;
+		uint64_t bytes = 0u;
+
+		const uint64_t start = ExodusTimer::Now();
+		for (uint32_t i = 0u; i < fileCount; ++i)
+		{
+			const AssetPriority priority = i % 100u == 0u ? AssetPriority::Critical : AssetPriority::Normal;
+			handles.push_back( assets.Load( FilePath( directory, i ), priority, [&]( AssetHandle handle, AssetState state )
+			{
+				++finished;
+				if (state == AssetState::Ready)
+				{
+					bytes += assets.GetData( handle ).size();
+				}
+				else
+				{
+					++failed;
+				}
+			} ) );
+		}
+		const uint64_t issued = ExodusTimer::Now();
+
+		std::vector<double> updates;
+		while (finished < fileCount)
+		{
+			const uint64_t frameStart = ExodusTimer::Now();
+			assets.Update();
+			updates.push_back( Bench::Seconds( frameStart, ExodusTimer::Now() ) * 1e3 );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+		const double seconds = Bench::Seconds( start, ExodusTimer::Now() );
+		const size_t frames = updates.size();
+		const double worst = Bench::Percentile( updates, 100.0 );
+		std::printf( "%u io threads  %6u files %7.1f MB  %8.1f files/s %7.1f MB/s  issue %6.2f ms  %5zu frames  Update p50 %6.3f ms max %6.3f ms%s\n",
+			ioThreads, fileCount, static_cast<double>(bytes) * 1e-6, fileCount / seconds, static_cast<double>(bytes) * 1e-6 / seconds,
+			Bench::Seconds( start, issued ) * 1e3, frames, Bench::Percentile( updates, 50.0 ), worst, failed ? "  (reads failed)" : "" );
+		for (const AssetHandle handle : handles)
+		{
+			assets.Release( handle );
+		}
+	}
+}
+
+int main( int argc, char** argv )
+{
+	const uint32_t fileCount = static_cast<uint32_t>(Bench::Argument( argc, argv, 1, 4000u ));
+	const size_t fileSize = static_cast<size_t>(Bench::Argument( argc, argv, 2, 64u )) * 1024u;
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "ExodusAssetStreamBench";
+	if (!WriteFiles( directory, fileCount, fileSize ))
+	{
+		std::printf( "couldn't write the files to %s\n", directory.string().c_str() );
+		return 1;
+	}
+	for (const uint32_t ioThreads : { 1u, 2u, 4u })
+	{
+		Stream( directory, fileCount, ioThreads );
+	}
+	std::filesystem::remove_all( directory );
+	return 0;
+}
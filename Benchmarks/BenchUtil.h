@@ -0,0 +1,53 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Support/ExodusTimer.h"
+
+// Shared bits of the benchmark executables. Results go to stdout as one line per measurement.
+namespace Exodus::Bench
+{
+	inline double Seconds( uint64_t start, uint64_t end ) noexcept
+	{
+		return static_cast<double>(end - start) * 1e-9;
+	}
+
+	// nearest rank, sorts samples
+	inline double Percentile( std::vector<double>& samples, double percentile )
+	{
+		if (samples.empty())
+		{
+			return 0.0;
+		}
+		std::sort( samples.begin(), samples.end() );
+		const size_t rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(samples.size() - 1u) + 0.5);
+		return samples[std::min( rank, samples.size() - 1u )];
+	}
+
+	// positional argument index, fallback when it is missing
+	inline uint64_t Argument( int argc, char** argv, int index, uint64_t fallback )
+	{
+		return index < argc ? std::strtoull( argv[index], nullptr, 10 ) : fallback;
+	}
+}
@@ -0,0 +1,334 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Application/EngineApplication.h"
+#include "BenchUtil.h"
+
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <string>
+
+// EcsBench [--replay log] [--record log]
+// Headless app (HeadlessEntry, NullBackend) with 1M entities and 20 systems of mixed read and
+// write sets. Runs 100 frames after a warm-up and reports the average time per system, the
+// frame's wall clock and the parallelism the scheduler achieved.
+
+using namespace Exodus;
+
+namespace
+{
+	struct Position { float x, y, z; };
+	struct Velocity { float x, y, z; };
+	struct Acceleration { float x, y, z; };
+	struct Rotation { float angle; };
+	struct Spin { float rate; };
+	struct Health { float value; };
+	struct Regen { float rate; };
+	struct Damage { float amount; };
+	struct Lifetime { float age; };
+	struct Color { float r, g, b, a; };
+	struct Scale { float value; };
+	struct Temperature { float value; };
+	struct Flags { uint32_t bits; };
+	struct AiState { uint32_t mode; float timer; };
+
+	std::atomic<uint64_t> g_sink = 0u;
+
+	void Accelerate( View<entt::get_t<Velocity, const Acceleration>> view, const FrameTime& time )
+	{
+		for (auto [entity, velocity, acceleration] : view.each())
+		{
+			velocity.x += acceleration.x * time.deltaTime;
+			velocity.y += acceleration.y * time.deltaTime;
+			velocity.z += acceleration.z * time.deltaTime;
+		}
+	}
+	void Move( View<entt::get_t<Position, const Velocity>> view, const FrameTime& time )
+	{
+		for (auto [entity, position, velocity] : view.each())
+		{
+			position.x += velocity.x * time.deltaTime;
+			position.y += velocity.y * time.deltaTime;
+			position.z += velocity.z * time.deltaTime;
+		}
+	}
+	void Rotate( View<entt::get_t<Rotation, const Spin>> view, const FrameTime& time )
+	{
+		for (auto [entity, rotation, spin] : view.each())
+		{
+			rotation.angle = std::fmod( rotation.angle + spin.rate * time.deltaTime, 6.2831853f );
+		}
+	}
+	void Heal( View<entt::get_t<Health, const Regen>> view, const FrameTime& time )
+	{
+		for (auto [entity, health, regen] : view.each())
+		{
+			health.value = std::min( health.value + regen.rate * time.deltaTime, 100.0f );
+		}
+	}
+	void Hurt( View<entt::get_t<Health, const Damage>> view )
+	{
+		for (auto [entity, health, damage] : view.each())
+		{
+			health.value -= damage.amount;
+		}
+	}
+	void Age( View<entt::get_t<Lifetime>> view, const FrameTime& time )
+	{
+		for (auto [entity, lifetime] : view.each())
+		{
+			lifetime.age += time.deltaTime;
+		}
+	}
+	void Fade( View<entt::get_t<Color, const Lifetime>> view )
+	{
+		for (auto [entity, color, lifetime] : view.each())
+		{
+			color.a = 1.0f / (1.0f + lifetime.age);
+		}
+	}
+	void Grow( View<entt::get_t<Scale, const Lifetime>> view )
+	{
+		for (auto [entity, scale, lifetime] : view.each())
+		{
+			scale.value = 1.0f + 0.1f * lifetime.age;
+		}
+	}
+	void Drag( View<entt::get_t<Acceleration, const Velocity>> view )
+	{
+		for (auto [entity, acceleration, velocity] : view.each())
+		{
+			acceleration.x = -0.1f * velocity.x;
+			acceleration.y = -0.1f * velocity.y - 9.81f;
+			acceleration.z = -0.1f * velocity.z;
+		}
+	}
+	void Bounds( View<entt::get_t<Flags, const Position>> view )
+	{
+		for (auto [entity, flags, position] : view.each())
+		{
+			flags.bits = (flags.bits & ~1u) | (position.y < -100.0f ? 1u : 0u);
+		}
+	}
+	void Heat( View<entt::get_t<Temperature, const Velocity>> view )
+	{
+		for (auto [entity, temperature, velocity] : view.each())
+		{
+			temperature.value += 0.001f * (velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+		}
+	}
+	void Cool( View<entt::get_t<Temperature>> view, const FrameTime& time )
+	{
+		for (auto [entity, temperature] : view.each())
+		{
+			temperature.value *= 1.0f - 0.5f * time.deltaTime;
+		}
+	}
+	void Glow( View<entt::get_t<Color, const Temperature>> view )
+	{
+		for (auto [entity, color, temperature] : view.each())
+		{
+			color.r = std::min( temperature.value * 0.01f, 1.0f );
+		}
+	}
+	void Think( View<entt::get_t<AiState, const Position, const Health>> view, const FrameTime& time )
+	{
+		for (auto [entity, ai, position, health] : view.each())
+		{
+			ai.timer -= time.deltaTime;
+			if (ai.timer <= 0.0f)
+			{
+				ai.mode = health.value < 25.0f ? 2u : (position.x > 0.0f ? 1u : 0u);
+				ai.timer = 0.5f;
+			}
+		}
+	}
+	void Steer( View<entt::get_t<Acceleration, const AiState>> view )
+	{
+		for (auto [entity, acceleration, ai] : view.each())
+		{
+			acceleration.x += ai.mode == 1u ? -1.0f : 1.0f;
+		}
+	}
+	void Orient( View<entt::get_t<Rotation, const Velocity>> view )
+	{
+		for (auto [entity, rotation, velocity] : view.each())
+		{
+			rotation.angle += 0.01f * velocity.x;
+		}
+	}
+	void CountOutside( View<entt::get_t<const Flags>> view )
+	{
+		uint64_t outside = 0u;
+		for (auto [entity, flags] : view.each())
+		{
+			outside += flags.bits & 1u;
+		}
+		g_sink += outside;
+	}
+	void SumHealth( View<entt::get_t<const Health, const Position>> view )
+	{
+		float sum = 0.0f;
+		for (auto [entity, health, position] : view.each())
+		{
+			sum += health.value + position.z * 0.0f;
+		}
+		g_sink += static_cast<uint64_t>(sum);
+	}
+	void Decay( View<entt::get_t<Damage>> view )
+	{
+		for (auto [entity, damage] : view.each())
+		{
+			damage.amount *= 0.9f;
+		}
+	}
+	void Tint( View<entt::get_t<Color, const Scale>> view )
+	{
+		for (auto [entity, color, scale] : view.each())
+		{
+			color.b = 1.0f / scale.value;
+		}
+	}
+
+	class EcsBench : public EngineApplication
+	{
+	public:
+		static constexpr uint32_t entityCount = 1'000'000u;
+		static constexpr uint32_t warmupFrames = 5u;
+		static constexpr uint32_t measuredFrames = 100u;
+	public:
+		EcsBench()
+			:
+			EngineApplication( 0, 0, "EcsBench", RunMode::Headless )
+		{
+			const uint64_t start = ExodusTimer::Now();
+			for (uint32_t i = 0u; i < entityCount; ++i)
+			{
+				const auto entity = Entities.create();
+				const float f = static_cast<float>(i % 1000u);
+				Entities.emplace<Position>( entity, f, 0.0f, -f );
+				Entities.emplace<Velocity>( entity, 1.0f, f * 0.01f, 0.0f );
+				Entities.emplace<Acceleration>( entity, 0.0f, 0.0f, 0.0f );
+				Entities.emplace<Lifetime>( entity, 0.0f );
+				if (i % 2u == 0u)
+				{
+					Entities.emplace<Rotation>( entity, 0.0f );
+					Entities.emplace<Spin>( entity, f * 0.001f );
+					Entities.emplace<Color>( entity, 1.0f, 1.0f, 1.0f, 1.0f );
+					Entities.emplace<Scale>( entity, 1.0f );
+				}
+				if (i % 3u == 0u)
+				{
+					Entities.emplace<Health>( entity, 100.0f );
+					Entities.emplace<Regen>( entity, 1.0f );
+					Entities.emplace<Damage>( entity, f * 0.01f );
+					Entities.emplace<AiState>( entity, 0u, 0.0f );
+				}
+				if (i % 4u == 0u)
+				{
+					Entities.emplace<Temperature>( entity, 20.0f );
+					Entities.emplace<Flags>( entity, 0u );
+				}
+			}
+			std::printf( "created %u entities in %.1f ms, %u job system threads\n",
+				entityCount, Bench::Seconds( start, ExodusTimer::Now() ) * 1e3, m_jobs->GetThreadCount() );
+
+			m_systems->AddSystem<&Accelerate>( "Accelerate" );
+			m_systems->AddSystem<&Move>( "Move" );
+			m_systems->AddSystem<&Rotate>( "Rotate" );
+			m_systems->AddSystem<&Heal>( "Heal" );
+			m_systems->AddSystem<&Hurt>( "Hurt" );
+			m_systems->AddSystem<&Age>( "Age" );
+			m_systems->AddSystem<&Fade>( "Fade" );
+			m_systems->AddSystem<&Grow>( "Grow" );
+			m_systems->AddSystem<&Drag>( "Drag" );
+			m_systems->AddSystem<&Bounds>( "Bounds" );
+			m_systems->AddSystem<&Heat>( "Heat" );
+			m_systems->AddSystem<&Cool>( "Cool" );
+			m_systems->AddSystem<&Glow>( "Glow" );
+			m_systems->AddSystem<&Think>( "Think" );
+			m_systems->AddSystem<&Steer>( "Steer" );
+			m_systems->AddSystem<&Orient>( "Orient" );
+			m_systems->AddSystem<&CountOutside>( "CountOutside" );
+			m_systems->AddSystem<&SumHealth>( "SumHealth" );
+			m_systems->AddSystem<&Decay>( "Decay" );
+			m_systems->AddSystem<&Tint>( "Tint" );
+		}
+
+		void HandleInput( float ) override
+		{
+		}
+
+		// runs before the systems, so it sees the stats of the previous frame's Execute()
+		void Update( float ) override
+		{
+			if (m_frame > warmupFrames)
+			{
+				for (size_t i = 0u; i < m_systems->GetSystemCount(); ++i)
+				{
+					const SystemScheduler::SystemStats stats = m_systems->GetStats( i );
+					SystemTotal& total = m_totals[stats.name];
+					total.time += stats.lastTime;
+					total.readCount = stats.readCount;
+					total.writeCount = stats.writeCount;
+				}
+				m_wallTime += m_systems->GetLastFrameTime();
+				m_parallelism.push_back( m_systems->GetParallelism() );
+			}
+			if (m_frame++ == warmupFrames + measuredFrames)
+			{
+				Report();
+				Quit( 0 );
+			}
+		}
+	private:
+		struct SystemTotal
+		{
+			double time = 0.0;
+			size_t readCount = 0u;
+			size_t writeCount = 0u;
+		};
+
+		void Report()
+		{
+			double systemTime = 0.0;
+			std::printf( "%-14s %4s %4s %10s\n", "system", "ro", "rw", "avg ms" );
+			for (const auto& [name, total] : m_totals)
+			{
+				std::printf( "%-14s %4zu %4zu %10.3f\n", name.c_str(), total.readCount, total.writeCount, total.time / measuredFrames * 1e3 );
+				systemTime += total.time;
+			}
+			std::printf( "summed system time %.3f ms  frame wall clock %.3f ms  parallelism avg %.2f p50 %.2f\n",
+				systemTime / measuredFrames * 1e3, m_wallTime / measuredFrames * 1e3,
+				systemTime / m_wallTime, Bench::Percentile( m_parallelism, 50.0 ) );
+		}
+	private:
+		uint32_t m_frame = 0u;
+		std::map<std::string, SystemTotal> m_totals;
+		double m_wallTime = 0.0;
+		std::vector<double> m_parallelism;
+	};
+}
+
+EngineApplication* CreateEngineApp()
+{
+	return new EcsBench();
+}
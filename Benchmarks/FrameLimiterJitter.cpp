@@ -0,0 +1,91 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Support/FrameLimiter.h"
+#include "BenchUtil.h"
+
+#include <cmath>
+#include <random>
+
+// FrameLimiterJitter [rate] [frames] [max work us]
+// Runs frames of random busy work (0 to max work microseconds) through a FrameLimiter and
+// reports how far each frame's length lands from 1 / rate: p50, p99 and max deviation, plus
+// the average frame rate, the overshoot the limiter learned and the share of time it waited. The first frames settle the
+// overshoot estimate and are left out.
+
+using namespace Exodus;
+
+namespace
+{
+	void Busy( uint64_t nanoseconds )
+	{
+		const uint64_t start = ExodusTimer::Now();
+		while (ExodusTimer::Now() - start < nanoseconds)
+		{
+		}
+	}
+}
+
+int main( int argc, char** argv )
+{
+	const float rate = static_cast<float>(Bench::Argument( argc, argv, 1, 144u ));
+	const uint32_t frames = static_cast<uint32_t>(Bench::Argument( argc, argv, 2, 2000u ));
+	const uint32_t maxWork = static_cast<uint32_t>(Bench::Argument( argc, argv, 3, 3000u ));
+	constexpr uint32_t warmupFrames = 20u;
+	if (rate <= 0.0f)
+	{
+		std::printf( "rate has to be positive\n" );
+		return 1;
+	}
+
+	const double target = 1e9 / static_cast<double>(rate);
+	FrameLimiter limiter( rate );
+	std::mt19937 random( 1u );
+	std::uniform_int_distribution<uint32_t> work( 0u, maxWork );
+	std::vector<double> deviations;
+	deviations.reserve( frames );
+	double waited = 0.0;
+	uint64_t previous = 0u;
+	uint64_t measuredStart = 0u;
+	for (uint32_t frame = 0u; frame < frames + warmupFrames; ++frame)
+	{
+		Busy( work( random ) * 1000ull );
+		const float wait = limiter.Wait( true );
+		const uint64_t now = ExodusTimer::Now();
+		if (frame == warmupFrames)
+		{
+			measuredStart = now;
+		}
+		else if (frame > warmupFrames)
+		{
+			deviations.push_back( std::fabs( static_cast<double>(now - previous) - target ) * 1e-3 );
+			waited += wait;
+		}
+		previous = now;
+	}
+	const double seconds = Bench::Seconds( measuredStart, previous );
+	const double p50 = Bench::Percentile( deviations, 50.0 );
+	const double p99 = Bench::Percentile( deviations, 99.0 );
+	const double worst = Bench::Percentile( deviations, 100.0 );
+	std::printf( "target %6.1f fps  measured %7.2f fps  deviation p50 %7.1f us  p99 %7.1f us  max %8.1f us  overshoot %6.1f us  waited %5.1f%%\n",
+		rate, static_cast<double>(deviations.size()) / seconds, p50, p99, worst,
+		limiter.GetSleepOvershoot() * 1e6, waited / seconds * 100.0 );
+	return 0;
+}
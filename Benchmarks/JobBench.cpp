@@ -0,0 +1,221 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Jobs/JobSystem.h"
+#include "BenchUtil.h"
+
+#include <atomic>
+#include <memory>
+
+// JobBench [workers] [jobs]
+// Throughput of the job system for jobs queued by the main thread (every one is stolen), jobs
+// spawned by a worker (its own queue, the others steal), ParallelFor, and the latency of
+// dependency chains built with RunAfter().
+
+using namespace Exodus;
+
+namespace
+{
+	struct ThreadCounts
+	{
+		explicit ThreadCounts( uint32_t threads )
+			:
+			counts( threads )
+		{
+		}
+		void Add() noexcept
+		{
+			const uint32_t index = JobSystem::GetThreadIndex();
+			if (index < counts.size())
+			{
+				counts[index].fetch_add( 1u, std::memory_order_relaxed );
+			}
+		}
+		// share of the jobs not run by thread
+		double OthersShare( uint32_t thread, uint64_t total ) const noexcept
+		{
+			return 1.0 - static_cast<double>(counts[thread].load()) / static_cast<double>(total);
+		}
+		std::vector<std::atomic<uint64_t>> counts;
+	};
+
+	void MainThreadJobs( JobSystem& jobs, uint32_t count )
+	{
+		ThreadCounts executed( jobs.GetThreadCount() );
+		JobCounter counter;
+		const uint64_t start = ExodusTimer::Now();
+		for (uint32_t i = 0u; i < count; ++i)
+		{
+			jobs.Run( [&executed]()
+			{
+				executed.Add();
+			}, &counter );
+		}
+		const uint64_t queued = ExodusTimer::Now();
+		jobs.Wait( counter );
+		const uint64_t end = ExodusTimer::Now();
+		std::printf( "main thread jobs    %8u jobs  enqueue %7.2f Mjobs/s  total %7.2f Mjobs/s  run off the main thread %5.1f%%\n",
+			count, count / Bench::Seconds( start, queued ) * 1e-6, count / Bench::Seconds( start, end ) * 1e-6,
+			executed.OthersShare( 0u, count ) * 100.0 );
+	}
+
+	void SpawnedJobs( JobSystem& jobs, uint32_t count )
+	{
+		ThreadCounts executed( jobs.GetThreadCount() );
+		JobCounter counter;
+		std::atomic<uint32_t> spawner = 0u;
+		const uint64_t start = ExodusTimer::Now();
+		jobs.Run( [&]()
+		{
+			spawner = JobSystem::GetThreadIndex();
+			for (uint32_t i = 0u; i < count; ++i)
+			{
+				jobs.Run( [&executed]()
+				{
+					executed.Add();
+				}, &counter );
+			}
+		}, &counter );
+		jobs.Wait( counter );
+		const uint64_t end = ExodusTimer::Now();
+		std::printf( "worker spawned jobs %8u jobs  total   %7.2f Mjobs/s  stolen from the spawner %5.1f%%\n",
+			count, count / Bench::Seconds( start, end ) * 1e-6, executed.OthersShare( spawner, count ) * 100.0 );
+	}
+
+	void ParallelSum( JobSystem& jobs, uint32_t count )
+	{
+		std::vector<uint32_t> values( count );
+		for (uint32_t i = 0u; i < count; ++i)
+		{
+			values[i] = i * 2654435761u;
+		}
+		uint64_t start = ExodusTimer::Now();
+		uint64_t serial = 0u;
+		for (const uint32_t value : values)
+		{
+			serial += value % 7u;
+		}
+		const double serialTime = Bench::Seconds( start, ExodusTimer::Now() );
+
+		std::atomic<uint64_t> parallel = 0u;
+		JobCounter counter;
+		start = ExodusTimer::Now();
+		jobs.ParallelFor( count, 16384u, [&]( uint32_t begin, uint32_t end )
+		{
+			uint64_t sum = 0u;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				sum += values[i] % 7u;
+			}
+			parallel.fetch_add( sum, std::memory_order_relaxed );
+		}, &counter );
+		jobs.Wait( counter );
+		const double parallelTime = Bench::Seconds( start, ExodusTimer::Now() );
+		std::printf( "parallel for        %8u items serial %7.2f ms  parallel %7.2f ms  speedup %5.2fx%s\n",
+			count, serialTime * 1e3, parallelTime * 1e3, serialTime / parallelTime, serial == parallel ? "" : "  WRONG SUM" );
+	}
+
+	void DependencyChain( JobSystem& jobs, uint32_t length )
+	{
+		std::vector<std::unique_ptr<JobCounter>> counters;
+		for (uint32_t i = 0u; i < length; ++i)
+		{
+			counters.push_back( std::make_unique<JobCounter>() );
+		}
+		std::atomic<uint32_t> next = 0u;
+		std::atomic<bool> ordered = true;
+		const uint64_t start = ExodusTimer::Now();
+		for (uint32_t i = 0u; i < length; ++i)
+		{
+			auto link = [&next, &ordered, i]()
+			{
+				if (next.fetch_add( 1u ) != i)
+				{
+					ordered = false;
+				}
+			};
+			if (i == 0u)
+			{
+				jobs.Run( link, counters[i].get() );
+			}
+			else
+			{
+				jobs.RunAfter( *counters[i - 1u], link, counters[i].get() );
+			}
+		}
+		jobs.Wait( *counters.back() );
+		const uint64_t end = ExodusTimer::Now();
+		std::printf( "dependency chain    %8u links %7.2f us per link%s\n",
+			length, Bench::Seconds( start, end ) * 1e6 / length, ordered ? "" : "  OUT OF ORDER" );
+	}
+
+	void FanOutFanIn( JobSystem& jobs, uint32_t stages, uint32_t width )
+	{
+		std::vector<std::unique_ptr<JobCounter>> counters;
+		for (uint32_t i = 0u; i < stages; ++i)
+		{
+			counters.push_back( std::make_unique<JobCounter>() );
+		}
+		std::vector<std::atomic<uint32_t>> done( stages );
+		std::atomic<bool> ordered = true;
+		const uint64_t start = ExodusTimer::Now();
+		for (uint32_t stage = 0u; stage < stages; ++stage)
+		{
+			for (uint32_t i = 0u; i < width; ++i)
+			{
+				auto task = [&, stage]()
+				{
+					// every job of the previous stage has to be finished
+					if (stage > 0u && done[stage - 1u].load() != width)
+					{
+						ordered = false;
+					}
+					done[stage].fetch_add( 1u );
+				};
+				if (stage == 0u)
+				{
+					jobs.Run( task, counters[stage].get() );
+				}
+				else
+				{
+					jobs.RunAfter( *counters[stage - 1u], task, counters[stage].get() );
+				}
+			}
+		}
+		jobs.Wait( *counters.back() );
+		const uint64_t end = ExodusTimer::Now();
+		std::printf( "fan out / fan in    %8u stages of %u jobs  %7.2f us per stage%s\n",
+			stages, width, Bench::Seconds( start, end ) * 1e6 / stages, ordered ? "" : "  OUT OF ORDER" );
+	}
+}
+
+int main( int argc, char** argv )
+{
+	const uint32_t workers = static_cast<uint32_t>(Bench::Argument( argc, argv, 1, 0u ));
+	const uint32_t count = static_cast<uint32_t>(Bench::Argument( argc, argv, 2, 1'000'000u ));
+	JobSystem jobs( workers );
+	std::printf( "%u workers\n", jobs.GetWorkerCount() );
+	MainThreadJobs( jobs, count );
+	SpawnedJobs( jobs, count );
+	ParallelSum( jobs, count * 16u );
+	DependencyChain( jobs, std::max( count / 100u, 1u ) );
+	FanOutFanIn( jobs, std::max( count / 10000u, 1u ), 64u );
+	return 0;
+}
@@ -0,0 +1,117 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ECS/Registry.h"
+#include "BenchUtil.h"
+
+#include <vector>
+
+// PagePoolBench [entities] [rounds]
+// The engine Registry (pages from the PagePool) against entt::registry on the stock allocator:
+// create entities with three components, iterate a two component view, destroy them all and
+// compact, rounds times over so pages are freed and taken again. Best of five runs each.
+
+using namespace Exodus;
+
+namespace
+{
+	struct Position
+	{
+		float x, y, z;
+	};
+	struct Velocity
+	{
+		float x, y, z;
+	};
+	struct Lifetime
+	{
+		float seconds;
+	};
+
+	struct Timings
+	{
+		double create = 1e9;
+		double iterate = 1e9;
+		double destroy = 1e9;
+	};
+
+	template<typename RegistryType>
+	Timings Measure( uint32_t entityCount, uint32_t rounds )
+	{
+		Timings best;
+		for (int run = 0; run < 5; ++run)
+		{
+			Timings timings = { 0.0, 0.0, 0.0 };
+			RegistryType registry;
+			std::vector<entt::entity> entities( entityCount );
+			for (uint32_t round = 0u; round < rounds; ++round)
+			{
+				const uint64_t start = ExodusTimer::Now();
+				for (entt::entity& entity : entities)
+				{
+					entity = registry.create();
+					registry.template emplace<Position>( entity, 0.0f, 0.0f, 0.0f );
+					registry.template emplace<Velocity>( entity, 1.0f, 1.0f, 1.0f );
+					registry.template emplace<Lifetime>( entity, 1.0f );
+				}
+				const uint64_t created = ExodusTimer::Now();
+				registry.template view<Position, const Velocity>().each( []( Position& position, const Velocity& velocity )
+				{
+					position.x += velocity.x;
+					position.y += velocity.y;
+					position.z += velocity.z;
+				} );
+				const uint64_t iterated = ExodusTimer::Now();
+				registry.destroy( entities.begin(), entities.end() );
+				registry.template storage<Position>().compact();
+				registry.template storage<Velocity>().compact();
+				registry.template storage<Lifetime>().compact();
+				const uint64_t destroyed = ExodusTimer::Now();
+				timings.create += Bench::Seconds( start, created );
+				timings.iterate += Bench::Seconds( created, iterated );
+				timings.destroy += Bench::Seconds( iterated, destroyed );
+			}
+			best.create = std::min( best.create, timings.create / rounds );
+			best.iterate = std::min( best.iterate, timings.iterate / rounds );
+			best.destroy = std::min( best.destroy, timings.destroy / rounds );
+		}
+		return best;
+	}
+
+	void Print( const char* name, uint32_t entityCount, const Timings& timings )
+	{
+		const double count = static_cast<double>(entityCount);
+		std::printf( "%-16s create %7.2f Ment/s  iterate %7.2f Ment/s  destroy %7.2f Ment/s\n", name,
+			count / timings.create * 1e-6, count / timings.iterate * 1e-6, count / timings.destroy * 1e-6 );
+	}
+}
+
+int main( int argc, char** argv )
+{
+	const uint32_t entityCount = static_cast<uint32_t>(Bench::Argument( argc, argv, 1, 1000000u ));
+	const uint32_t rounds = static_cast<uint32_t>(std::max<uint64_t>( Bench::Argument( argc, argv, 2, 3u ), 1u ));
+
+	Print( "stock allocator", entityCount, Measure<entt::registry>( entityCount, rounds ) );
+	Print( "page pool", entityCount, Measure<Registry>( entityCount, rounds ) );
+	const PagePool::Stats stats = PagePool::Get().GetStats();
+	std::printf( "page pool holds %llu slabs (%.1f MB) after the registries are gone\n",
+		static_cast<unsigned long long>(stats.slabCount), static_cast<double>(stats.slabBytes) / (1024.0 * 1024.0) );
+	return 0;
+}
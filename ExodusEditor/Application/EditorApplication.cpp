@@ -35,10 +35,18 @@ namespace Exodus
 
 	void EditorApplication::HandleInput( float deltaTime )
 	{
-		if(m_wnd->kbd.KeyIsPressed( VK_F11 ))
+		if(GetInput().KeyWasPressed( VK_F11 ))
 		{
 			m_wnd->SetFullscreen();
 		}
+		if (GetInput().KeyWasPressed( VK_F2 ))
+		{
+			m_showProfiler = !m_showProfiler;
+		}
+		if (GetInput().KeyWasPressed( VK_F3 ))
+		{
+			m_showMemory = !m_showMemory;
+		}
 	}
 
 	void EditorApplication::Update( float DeltaTime )
@@ -46,6 +54,22 @@ namespace Exodus
 		
 	}
 
+	void EditorApplication::Render( float alpha )
+	{
+		if (!IsImGuiFrameOpen())
+		{
+			return;
+		}
+		if (m_showProfiler)
+		{
+			m_profilerWindow.Draw( &m_showProfiler );
+		}
+		if (m_showMemory)
+		{
+			m_memoryWindow.Draw( &m_showMemory );
+		}
+	}
+
 }
 
 Exodus::EngineApplication* CreateEngineApp()
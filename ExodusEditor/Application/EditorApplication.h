@@ -21,6 +21,9 @@
 
 #include "Windows/WinEntry.cpp"
 #include "Application/EngineApplication.h"
+#include "Windows/Window.h"
+#include "Memory/MemoryWindow.h"
+#include "Profiling/ProfilerWindow.h"
 
 namespace Exodus
 {
@@ -32,5 +35,13 @@ namespace Exodus
 
 		void HandleInput( float deltaTime ) override;
 		void Update( float DeltaTime ) override;
+		void Render( float alpha ) override;
+	private:
+		// F2 toggles it
+		ProfilerWindow m_profilerWindow;
+		bool m_showProfiler = true;
+		// F3 toggles it
+		MemoryWindow m_memoryWindow;
+		bool m_showMemory = true;
 	};
 }
@@ -19,68 +19,484 @@
 ******************************************************************************************/
 #include "exopch.h"
 #include "EngineApplication.h"
-#include "Debug/DXDebugLayer.h"
-#include "D3D/DXContext.h"
+#include "NullBackend.h"
+#include "Memory/MemoryTracker.h"
+#include "Memory/TrackedAllocator.h"
+#include "Profiling/Profiler.h"
+#if defined(_WIN32)
+#include "Win32Backend.h"
+#include "Windows/Window.h"
+
+#include <filesystem>
+#endif
 
 namespace Exodus
 {
 
-	EngineApplication::EngineApplication( int width, int height, std::string title )
+	EngineApplication::EngineApplication( int width, int height, std::string title, RunMode mode )
 	{
-		m_wnd = new Window( width, height, title.c_str() );
-		m_timer = new ExodusTimer();
+#if defined(_WIN32)
+		if (mode == RunMode::Windowed)
+		{
+			m_wnd = TrackedNew<MemoryTag::General, Window>( width, height, title.c_str() );
+			m_backend = TrackedNew<MemoryTag::General, Win32Backend>( m_wnd );
+		}
+#else
+		// there is no windowed backend to hand them to
+		(void)width;
+		(void)height;
+		(void)title;
+		(void)mode;
+#endif
+		if (!m_backend)
+		{
+			m_nullBackend = TrackedNew<MemoryTag::General, NullBackend>();
+			m_backend = m_nullBackend;
+		}
+		m_timer = TrackedNew<MemoryTag::General, ExodusTimer>();
+		m_jobs = TrackedNew<MemoryTag::General, JobSystem>();
+		m_frameMemory = TrackedNew<MemoryTag::Scratch, FrameMemory>( m_jobs->GetThreadCount() );
+		m_systems = TrackedNew<MemoryTag::ECS, SystemScheduler>( Entities, *m_jobs );
+		m_changes = TrackedNew<MemoryTag::ECS, DeltaTracker>( Entities );
+		m_assets = TrackedNew<MemoryTag::Assets, AssetManager>();
 	}
 
 	EngineApplication::~EngineApplication()
 	{
-
+		TrackedDelete<MemoryTag::Assets>( m_watcher );
+		TrackedDelete<MemoryTag::Assets>( m_assets );
+		TrackedDelete<MemoryTag::Input>( m_player );
+		TrackedDelete<MemoryTag::Input>( m_recorder );
+		TrackedDelete<MemoryTag::ECS>( m_changes );
+		TrackedDelete<MemoryTag::ECS>( m_systems );
+		TrackedDelete<MemoryTag::Scratch>( m_frameMemory );
+		TrackedDelete<MemoryTag::General>( m_jobs );
+		TrackedDelete<MemoryTag::General>( m_timer );
+		// deleted as the type they were created with, so the tracker gets their real size
+		if (m_nullBackend)
+		{
+			TrackedDelete<MemoryTag::General>( m_nullBackend );
+		}
+#if defined(_WIN32)
+		else
+		{
+			TrackedDelete<MemoryTag::General>( static_cast<Win32Backend*>(m_backend) );
+		}
+		TrackedDelete<MemoryTag::General>( m_wnd );
+#endif
 	}
 
-	bool EngineApplication::Run()
+	int EngineApplication::Run()
 	{
 		if (Init())
 		{
+			EXODUS_PROFILE_THREAD( "Main" );
 			while (true)
 			{
-				// process all messages pending, but to not block for new messages
-				if (const auto ecode = Window::ProcessMessages())
+				EXODUS_PROFILE_FRAME();
+				MemoryTracker::Get().FrameBoundary();
+				EXODUS_PROFILE_ZONE( "Frame" );
+				m_frameMemory->Reset();
+				{
+					EXODUS_PROFILE_ZONE( "FrameLatencyWait" );
+					m_frameStats.latencyWait = m_backend->WaitForFrame();
+				}
+				if (const auto ecode = m_backend->ProcessMessages())
 				{
 					// if return optional has value, means we're quitting so return exit code
 					Shutdown();
 					return *ecode;
 				}
-				if (m_wnd->ShouldResize())
-				{					
-					DXContext::Get().Resize( m_wnd );
+				if (m_quitCode)
+				{
+					Shutdown();
+					return *m_quitCode;
+				}
+				// callbacks workers queued for the main thread run before this frame's logic
+				{
+					EXODUS_PROFILE_ZONE( "MainThreadJobs" );
+					m_jobs->ProcessMainThreadJobs();
+				}
+				if (m_watcher)
+				{
+					EXODUS_PROFILE_ZONE( "FileChanges" );
+					ApplyFileChanges();
+				}
+				{
+					EXODUS_PROFILE_ZONE( "AssetCallbacks" );
+					m_assets->Update();
+				}
+				if (!GatherInput())
+				{
+					// replay log exhausted
+					Shutdown();
+					return 0;
 				}
 				// execute the game logic
-				const auto dt = m_timer->Mark() * m_speedFactor;
-				DXContext::Get().InitCommandList();
-				HandleInput( dt );
-				Update( dt );
-				DXContext::Get().ExecuteCommandList();
-				DXContext::Get().Present();
+				m_frameStats.frameTime = m_player ? m_inputFrame.deltaTime : m_timer->Mark();
+				const float dt = m_player ? m_inputFrame.deltaTime : m_frameStats.frameTime * m_speedFactor;
+				if (m_recorder)
+				{
+					m_inputFrame.deltaTime = dt;
+					m_recorder->WriteFrame( m_inputFrame );
+				}
+				m_backend->BeginFrame();
+				{
+					EXODUS_PROFILE_ZONE( "HandleInput" );
+					HandleInput( dt );
+				}
+				if (m_useFixedStep)
+				{
+					const uint32_t steps = m_fixedStep.Advance( dt );
+					for (uint32_t i = 0u; i < steps; ++i)
+					{
+						EXODUS_PROFILE_ZONE( "Update" );
+						Update( m_fixedStep.GetStep() );
+						m_systems->Execute( m_fixedStep.GetStep() );
+						CommitChanges();
+					}
+				}
+				else
+				{
+					EXODUS_PROFILE_ZONE( "Update" );
+					Update( dt );
+					m_systems->Execute( dt );
+					CommitChanges();
+				}
+				{
+					EXODUS_PROFILE_ZONE( "Render" );
+					Render( GetInterpolationAlpha() );
+				}
+				m_backend->EndFrame();
+				// a replay runs as fast as it can
+				if (!m_player)
+				{
+					EXODUS_PROFILE_ZONE( "FrameLimiter" );
+					m_frameStats.limiterWait = m_limiter.Wait( !m_inputFrame.events.empty() );
+				}
 			}
 		}
 		return -1;
 	}
 
+	void EngineApplication::SetMaxFrameLatency( uint32_t frames )
+	{
+		m_backend->SetMaxFrameLatency( frames );
+	}
+
+	const EngineApplication::FrameStats& EngineApplication::GetFrameStats() const noexcept
+	{
+		return m_frameStats;
+	}
+
+	void EngineApplication::SetFrameRateLimit( float framesPerSecond ) noexcept
+	{
+		m_limiter.SetTargetRate( framesPerSecond );
+	}
+
+	void EngineApplication::SetIdleFrameRate( float framesPerSecond, float idleDelay ) noexcept
+	{
+		m_limiter.SetIdleRate( framesPerSecond, idleDelay );
+	}
+
+	bool EngineApplication::IsHeadless() const noexcept
+	{
+		return m_nullBackend != nullptr;
+	}
+
+	void EngineApplication::SetTickRate( float ticksPerSecond ) noexcept
+	{
+		if (m_nullBackend)
+		{
+			m_nullBackend->SetTickRate( ticksPerSecond );
+		}
+	}
+
+	void EngineApplication::Quit( int exitCode ) noexcept
+	{
+		m_quitCode = exitCode;
+	}
+
+	void EngineApplication::Render( float )
+	{
+	}
+
+	bool EngineApplication::IsImGuiFrameOpen() const
+	{
+		return m_backend->IsImGuiFrameOpen();
+	}
+
+	bool EngineApplication::EnableFixedTimestep( float tickRate, uint32_t maxStepsPerFrame ) noexcept
+	{
+		if (!m_fixedStep.SetTickRate( tickRate ))
+		{
+			return false;
+		}
+		m_fixedStep.SetMaxStepsPerFrame( maxStepsPerFrame );
+		m_fixedStep.Reset();
+		m_useFixedStep = true;
+		return true;
+	}
+
+	void EngineApplication::DisableFixedTimestep() noexcept
+	{
+		m_useFixedStep = false;
+	}
+
+	float EngineApplication::GetInterpolationAlpha() const noexcept
+	{
+		return m_useFixedStep ? m_fixedStep.GetAlpha() : 1.0f;
+	}
+
+	bool EngineApplication::RecordInput( const std::string& path )
+	{
+		if (!m_recorder)
+		{
+			m_recorder = TrackedNew<MemoryTag::Input, InputRecorder>();
+		}
+		return m_recorder->Open( path );
+	}
+
+	void EngineApplication::StopRecordingInput()
+	{
+		TrackedDelete<MemoryTag::Input>( m_recorder );
+		m_recorder = nullptr;
+	}
+
+	bool EngineApplication::ReplayInput( const std::string& path )
+	{
+		InputPlayer* player = TrackedNew<MemoryTag::Input, InputPlayer>();
+		if (!player->Open( path ))
+		{
+			TrackedDelete<MemoryTag::Input>( player );
+			return false;
+		}
+		TrackedDelete<MemoryTag::Input>( m_player );
+		m_player = player;
+		return true;
+	}
+
+	bool EngineApplication::IsReplaying() const noexcept
+	{
+		return m_player != nullptr;
+	}
+
+	FrameMemory& EngineApplication::GetFrameMemory() noexcept
+	{
+		return *m_frameMemory;
+	}
+
+	AssetManager& EngineApplication::GetAssets() noexcept
+	{
+		return *m_assets;
+	}
+
+	bool EngineApplication::WatchForChanges( const std::string& directory )
+	{
+		if (!m_watcher)
+		{
+			m_watcher = TrackedNew<MemoryTag::Assets, FileWatcher>();
+#if defined(_WIN32)
+			// only the layout file's own directory, it usually sits next to the executable
+			if (m_wnd)
+			{
+				const std::string layout = m_wnd->GetImGuiLayoutPath();
+				if (!layout.empty())
+				{
+					const std::string layoutDirectory = std::filesystem::path( layout ).parent_path().string();
+					m_watcher->Watch( layoutDirectory.empty() ? "." : layoutDirectory, false );
+				}
+			}
+#endif
+		}
+		return m_watcher->Watch( directory );
+	}
+
+	void EngineApplication::SetRewindDepth( uint32_t ticks )
+	{
+		m_rewindDepth = ticks;
+		while (m_history.size() > m_rewindDepth)
+		{
+			m_history.pop_front();
+		}
+	}
+
+	uint32_t EngineApplication::Rewind( uint32_t ticks )
+	{
+		// changes made since the last step are undone first
+		m_changes->Revert( m_changes->Commit() );
+		uint32_t undone = 0u;
+		for (; undone < ticks && !m_history.empty(); ++undone)
+		{
+			m_changes->Revert( m_history.back() );
+			m_history.pop_back();
+		}
+		return undone;
+	}
+
+	const InputSnapshot& EngineApplication::GetInput() const noexcept
+	{
+		return m_input.Get();
+	}
 
 	bool EngineApplication::Init()
 	{
-		Exodus::DXDebugLayer::Get().Init();
-		if (Exodus::DXContext::Get().Init(m_wnd))
+		return m_backend->Init();
+	}
+
+	bool EngineApplication::GatherInput()
+	{
+		EXODUS_PROFILE_ZONE( "GatherInput" );
+		if (m_player)
+		{
+			// window input is ignored while a log drives the frame
+			if (!m_player->ReadFrame( m_inputFrame ))
+			{
+				return false;
+			}
+		}
+		else
 		{
-			return true;
+			m_inputFrame.timestamp = ExodusTimer::Now();
+			m_inputFrame.events.clear();
+			PollWindowInput();
 		}
-		DXContext::Get().Shutdown();
-		return false;
+		m_input.Begin( m_inputFrame.timestamp );
+		for (const InputEvent& e : m_inputFrame.events)
+		{
+			m_input.Apply( e );
+		}
+		m_input.End();
+		return true;
+	}
+
+	void EngineApplication::PollWindowInput()
+	{
+#if defined(_WIN32)
+		if (!m_wnd)
+		{
+			return;
+		}
+		auto& events = m_inputFrame.events;
+		// drains the window's event queues, Keyboard/Mouse Read*() see nothing after this
+		while (const auto e = m_wnd->kbd.ReadKey())
+		{
+			events.push_back( { InputEvent::Type::Key, e->GetCode(), e->IsPress(), 0, 0, e->GetTimestamp() } );
+		}
+		while (const auto c = m_wnd->kbd.ReadChar())
+		{
+			events.push_back( { InputEvent::Type::Char, static_cast<uint8_t>(*c) } );
+		}
+		const InputSnapshot& last = m_input.Get();
+		int x = last.mouseX;
+		int y = last.mouseY;
+		while (const auto e = m_wnd->mouse.Read())
+		{
+			switch (e->GetType())
+			{
+			case Mouse::Event::Type::LPress:
+			case Mouse::Event::Type::LRelease:
+				events.push_back( { InputEvent::Type::Button, InputSnapshot::Left, e->LeftIsPressed(), 0, 0, e->GetTimestamp() } );
+				break;
+			case Mouse::Event::Type::RPress:
+			case Mouse::Event::Type::RRelease:
+				events.push_back( { InputEvent::Type::Button, InputSnapshot::Right, e->RightIsPressed(), 0, 0, e->GetTimestamp() } );
+				break;
+			case Mouse::Event::Type::WheelUp:
+				events.push_back( { InputEvent::Type::Wheel, 0u, false, 1 } );
+				break;
+			case Mouse::Event::Type::WheelDown:
+				events.push_back( { InputEvent::Type::Wheel, 0u, false, -1 } );
+				break;
+			case Mouse::Event::Type::Enter:
+				events.push_back( { InputEvent::Type::MouseInWindow, 0u, true } );
+				break;
+			case Mouse::Event::Type::Leave:
+				events.push_back( { InputEvent::Type::MouseInWindow, 0u, false } );
+				break;
+			default:
+				break;
+			}
+			// every event carries the position, only keep the ones that moved
+			if (e->GetPosX() != x || e->GetPosY() != y)
+			{
+				x = e->GetPosX();
+				y = e->GetPosY();
+				events.push_back( { InputEvent::Type::MouseMove, 0u, false, x, y, e->GetTimestamp() } );
+			}
+		}
+		// the snapshot only wants the sum, one event keeps high rate mice out of the log
+		InputEvent raw = { InputEvent::Type::RawDelta };
+		while (const auto d = m_wnd->mouse.ReadRawDelta())
+		{
+			raw.x += d->x;
+			raw.y += d->y;
+		}
+		if (raw.x != 0 || raw.y != 0)
+		{
+			events.push_back( raw );
+		}
+#endif
+	}
+
+	void EngineApplication::CommitChanges()
+	{
+		if (!m_changes->IsTracking())
+		{
+			return;
+		}
+		EXODUS_PROFILE_ZONE( "CommitChanges" );
+		// committed without a history too, or the tracker's pending changes would grow forever
+		RegistryDelta delta = m_changes->Commit();
+		if (m_rewindDepth == 0u)
+		{
+			return;
+		}
+		m_history.push_back( std::move( delta ) );
+		if (m_history.size() > m_rewindDepth)
+		{
+			m_history.pop_front();
+		}
+	}
+
+	void EngineApplication::ApplyFileChanges()
+	{
+		m_watcher->Drain( m_fileChanges );
+		if (m_fileChanges.empty())
+		{
+			return;
+		}
+		m_assets->OnFilesChanged( m_fileChanges );
+#if defined(_WIN32)
+		if (m_wnd)
+		{
+			const std::string layout = m_wnd->GetImGuiLayoutPath();
+			for (const FileChange& change : m_fileChanges)
+			{
+				if (change.path == layout && change.type != FileChange::Type::Removed)
+				{
+					m_wnd->ReloadImGuiLayout();
+					break;
+				}
+			}
+		}
+#endif
+		m_fileChanges.clear();
 	}
 
 	void EngineApplication::Shutdown()
 	{
-		Exodus::DXContext::Get().Shutdown();
-		Exodus::DXDebugLayer::Get().Shutdown();
+		if (m_recorder)
+		{
+			m_recorder->Close();
+		}
+		if (m_watcher)
+		{
+			m_watcher->Stop();
+		}
+		m_assets->Shutdown();
+		m_jobs->Shutdown();
+		m_backend->Shutdown();
 	}
 
 }
\ No newline at end of file
@@ -18,30 +18,135 @@
 *	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
 ******************************************************************************************/
 #pragma once
+#include <deque>
+#include <optional>
 #include <string>
-#include "Windows/Window.h"
+#include <vector>
 #include "ExodusTimer.h"
-
-#include "entt.hpp" // https://github.com/skypjack/entt
+#include "FixedTimestep.h"
+#include "FrameLimiter.h"
+#include "FileWatcher.h"
+#include "PlatformBackend.h"
+#include "Assets/AssetManager.h"
+#include "Input/InputLog.h"
+#include "Input/InputSnapshot.h"
+#include "Jobs/JobSystem.h"
+#include "Memory/FrameMemory.h"
+#include "ECS/Registry.h"
+#include "ECS/DeltaTracker.h"
+#include "ECS/SystemScheduler.h"
 
 namespace Exodus
 {
+	class Window;
+	class NullBackend;
+
+	enum class RunMode
+	{
+		Windowed,
+		// no window or graphics device, for servers and soak tests (m_wnd is nullptr)
+		Headless,
+	};
+
 	class EngineApplication
 	{
 	public:
-		EngineApplication( int width, int height, std::string title);
+		struct FrameStats
+		{
+			// seconds, before the speed factor
+			float frameTime = 0.0f;
+			// part of frameTime spent waiting for the display in low-latency mode
+			float latencyWait = 0.0f;
+			// part of frameTime slept away by the frame limiter
+			float limiterWait = 0.0f;
+		};
+	public:
+		EngineApplication( int width, int height, std::string title, RunMode mode = RunMode::Windowed );
 		~EngineApplication();
-		bool Run();
+		int Run();
 		virtual void HandleInput(float deltaTime) = 0;
+		// simulation, once per fixed step when the fixed timestep is on
 		virtual void Update(float DeltaTime) = 0;
+		// Drawing, once per frame after the simulation and before the frame is presented.
+		// alpha is GetInterpolationAlpha(), for blending the last two simulation states.
+		virtual void Render( float alpha );
+		// true inside Render() when ImGui windows can be drawn, never when headless
+		bool IsImGuiFrameOpen() const;
+		bool IsHeadless() const noexcept;
+		// headless only, 0 runs ticks back to back
+		void SetTickRate( float ticksPerSecond ) noexcept;
+		void Quit( int exitCode = 0 ) noexcept;
+		// Update() and the systems then run in whole steps of 1 / tickRate, HandleInput() and
+		// Render() stay once per frame. false for a tickRate that isn't positive.
+		bool EnableFixedTimestep( float tickRate, uint32_t maxStepsPerFrame = 5u ) noexcept;
+		void DisableFixedTimestep() noexcept;
+		// how far the current frame lies between the last two simulation steps, 1 without fixed timestep
+		float GetInterpolationAlpha() const noexcept;
+		// keyboard and mouse state for the current frame, use this instead of polling m_wnd
+		const InputSnapshot& GetInput() const noexcept;
+		// writes every frame's input events and delta time to path until stopped
+		bool RecordInput( const std::string& path );
+		void StopRecordingInput();
+		// drives input and delta time from a recorded log instead of the window and timer,
+		// Run() returns 0 when the log ends. Use with RunMode::Headless for benchmark runs.
+		bool ReplayInput( const std::string& path );
+		bool IsReplaying() const noexcept;
+		// per-thread scratch memory, reset at the start of every frame
+		FrameMemory& GetFrameMemory() noexcept;
+		// asynchronous file loads, callbacks run at the start of the frame before HandleInput()
+		AssetManager& GetAssets() noexcept;
+		// reloads assets loaded from below directory when their files change, plus the ImGui
+		// layout file when there is a window. Changes are applied at the start of the frame.
+		bool WatchForChanges( const std::string& directory );
+		// keeps the deltas of the last ticks simulation steps for Rewind(), 0 turns the history off.
+		// Only components registered with m_changes->Track<T>() are covered.
+		void SetRewindDepth( uint32_t ticks );
+		// reverts Entities by up to ticks simulation steps, returns how many were undone
+		uint32_t Rewind( uint32_t ticks );
+		// Low-latency mode, call before Run(): each frame first waits until the display can take
+		// another one, then pumps messages and samples input, so input is as fresh as possible.
+		// frames is how many presents may be queued, 1 is the lowest latency, 0 turns it off.
+		void SetMaxFrameLatency( uint32_t frames );
+		const FrameStats& GetFrameStats() const noexcept;
+		// caps the frame rate without spinning a core, for running with vsync off. 0 doesn't limit.
+		void SetFrameRateLimit( float framesPerSecond ) noexcept;
+		// editor idle mode: drops to framesPerSecond once no input arrived for idleDelay seconds, 0 turns it off
+		void SetIdleFrameRate( float framesPerSecond, float idleDelay = 1.0f ) noexcept;
 	private:
 		bool Init();
+		// false when the replay log is exhausted
+		bool GatherInput();
+		void PollWindowInput();
+		void CommitChanges();
+		void ApplyFileChanges();
 		void Shutdown();
 	protected:
-		Window* m_wnd;
+		Window* m_wnd = nullptr;
 		ExodusTimer* m_timer;
+		JobSystem* m_jobs;
+		SystemScheduler* m_systems;
+		FrameMemory* m_frameMemory;
+		DeltaTracker* m_changes;
+		AssetManager* m_assets;
 		float m_speedFactor = 1.0f;
-		entt::registry Entities;
+		Registry Entities;
+	private:
+		PlatformBackend* m_backend = nullptr;
+		NullBackend* m_nullBackend = nullptr;
+		std::optional<int> m_quitCode;
+		FixedTimestep m_fixedStep;
+		FrameStats m_frameStats;
+		FrameLimiter m_limiter;
+		bool m_useFixedStep = false;
+		InputSnapshotBuilder m_input;
+		InputFrame m_inputFrame;
+		InputRecorder* m_recorder = nullptr;
+		InputPlayer* m_player = nullptr;
+		std::deque<RegistryDelta> m_history;
+		uint32_t m_rewindDepth = 0u;
+		// created by the first WatchForChanges()
+		FileWatcher* m_watcher = nullptr;
+		std::vector<FileChange> m_fileChanges;
 	};
 }
 // To be defined in CLIENT
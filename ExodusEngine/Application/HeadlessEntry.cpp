@@ -0,0 +1,68 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Application/EngineApplication.h"
+#include "Support/ExodusException.h"
+#include "Profiling/TraceExporter.h"
+
+#include <cstring>
+#include <iostream>
+
+// Console entry point for headless clients (dedicated servers, soak tests). Include it from
+// the client instead of Windows/WinEntry.cpp and construct the app with RunMode::Headless.
+// --replay <log> drives the run from a recorded input log, --record <log> writes one.
+extern Exodus::EngineApplication* CreateEngineApp();
+
+int main( int argc, char** argv )
+{
+	try
+	{
+		Exodus::EngineApplication* app = CreateEngineApp();
+		for (int i = 1; i + 1 < argc; ++i)
+		{
+			if (std::strcmp( argv[i], "--replay" ) == 0 && !app->ReplayInput( argv[i + 1] ))
+			{
+				std::cerr << "Could not open input log " << argv[i + 1] << std::endl;
+				return -1;
+			}
+			if (std::strcmp( argv[i], "--record" ) == 0 && !app->RecordInput( argv[i + 1] ))
+			{
+				std::cerr << "Could not create input log " << argv[i + 1] << std::endl;
+				return -1;
+			}
+		}
+		return app->Run();
+	}
+	catch (const Exodus::ExodusException& e)
+	{
+		// keep the last recorded frames around for whoever investigates the error
+		Exodus::TraceExporter::Get().DumpNow( "ExodusError.trace.json" );
+		std::cerr << e.GetType() << std::endl << e.what() << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Standard Exception" << std::endl << e.what() << std::endl;
+	}
+	catch (...)
+	{
+		std::cerr << "Unknown Exception" << std::endl << "No details available" << std::endl;
+	}
+	return -1;
+}
@@ -0,0 +1,98 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "NullBackend.h"
+
+#include <thread>
+
+using namespace std::chrono;
+
+namespace Exodus
+{
+	NullBackend::NullBackend( float tickRate ) noexcept
+		:
+		m_tickRate( tickRate )
+	{
+	}
+
+	bool NullBackend::Init()
+	{
+		m_nextTick = steady_clock::now();
+		return true;
+	}
+
+	void NullBackend::Shutdown()
+	{
+	}
+
+	std::optional<int> NullBackend::ProcessMessages()
+	{
+		return {};
+	}
+
+	float NullBackend::WaitForFrame()
+	{
+		return 0.0f;
+	}
+
+	void NullBackend::SetMaxFrameLatency( uint32_t )
+	{
+	}
+
+	void NullBackend::BeginFrame()
+	{
+	}
+
+	void NullBackend::EndFrame()
+	{
+		if (m_tickRate <= 0.0f)
+		{
+			return;
+		}
+		const auto tickLength = duration_cast<steady_clock::duration>( duration<float>( 1.0f / m_tickRate ) );
+		m_nextTick += tickLength;
+		const auto now = steady_clock::now();
+		if (m_nextTick > now)
+		{
+			std::this_thread::sleep_until( m_nextTick );
+		}
+		else if (now - m_nextTick > tickLength)
+		{
+			// fell more than a tick behind, don't try to make up for it with a burst of frames
+			m_nextTick = now;
+		}
+	}
+
+	bool NullBackend::IsImGuiFrameOpen() const
+	{
+		return false;
+	}
+
+	void NullBackend::SetTickRate( float tickRate ) noexcept
+	{
+		m_tickRate = tickRate;
+		m_nextTick = steady_clock::now();
+	}
+
+	float NullBackend::GetTickRate() const noexcept
+	{
+		return m_tickRate;
+	}
+}
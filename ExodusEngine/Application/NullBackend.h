@@ -0,0 +1,46 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <chrono>
+#include "PlatformBackend.h"
+
+namespace Exodus
+{
+	// Headless backend, no window and no graphics device. Frames are paced to a fixed
+	// tick rate, or run back to back when the rate is 0.
+	class NullBackend : public PlatformBackend
+	{
+	public:
+		explicit NullBackend( float tickRate = 0.0f ) noexcept;
+		bool Init() override;
+		void Shutdown() override;
+		std::optional<int> ProcessMessages() override;
+		float WaitForFrame() override;
+		void SetMaxFrameLatency( uint32_t frames ) override;
+		void BeginFrame() override;
+		void EndFrame() override;
+		bool IsImGuiFrameOpen() const override;
+		void SetTickRate( float tickRate ) noexcept;
+		float GetTickRate() const noexcept;
+	private:
+		float m_tickRate;
+		std::chrono::steady_clock::time_point m_nextTick;
+	};
+}
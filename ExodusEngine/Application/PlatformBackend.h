@@ -0,0 +1,46 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <optional>
+
+namespace Exodus
+{
+	// What EngineApplication::Run() needs from the platform: a message pump and a frame
+	// to record into. The windowed backend pairs Window with DXContext, the null backend
+	// lets the simulation loop run without either.
+	class PlatformBackend
+	{
+	public:
+		virtual ~PlatformBackend() = default;
+		virtual bool Init() = 0;
+		virtual void Shutdown() = 0;
+		// returns an exit code once the application should quit
+		virtual std::optional<int> ProcessMessages() = 0;
+		// blocks until the display can take another frame, returns the seconds waited
+		virtual float WaitForFrame() = 0;
+		// presents allowed to queue up in low-latency mode, 0 turns it off
+		virtual void SetMaxFrameLatency( uint32_t frames ) = 0;
+		virtual void BeginFrame() = 0;
+		virtual void EndFrame() = 0;
+		// ImGui windows can be drawn between BeginFrame() and EndFrame()
+		virtual bool IsImGuiFrameOpen() const = 0;
+	};
+}
@@ -0,0 +1,127 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Win32Backend.h"
+#include "Debug/DXDebugLayer.h"
+#include "D3D/DXContext.h"
+#include "Profiling/Profiler.h"
+#include "Support/ExodusTimer.h"
+
+// imgui
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_win32.h"
+
+namespace Exodus
+{
+	Win32Backend::Win32Backend( Window* wnd ) noexcept
+		:
+		m_wnd( wnd )
+	{
+	}
+
+	bool Win32Backend::Init()
+	{
+		Exodus::DXDebugLayer::Get().Init();
+		if (Exodus::DXContext::Get().Init( m_wnd ))
+		{
+			m_resize.Reset( m_wnd->GetWidth(), m_wnd->GetHeight() );
+			return true;
+		}
+		DXContext::Get().Shutdown();
+		return false;
+	}
+
+	void Win32Backend::Shutdown()
+	{
+		Exodus::DXContext::Get().Shutdown();
+		Exodus::DXDebugLayer::Get().Shutdown();
+	}
+
+	std::optional<int> Win32Backend::ProcessMessages()
+	{
+		// process all messages pending, but to not block for new messages
+		EXODUS_PROFILE_ZONE( "ProcessMessages" );
+		return Window::ProcessMessages();
+	}
+
+	float Win32Backend::WaitForFrame()
+	{
+		return DXContext::Get().WaitForFrameLatency();
+	}
+
+	void Win32Backend::SetMaxFrameLatency( uint32_t frames )
+	{
+		DXContext::Get().SetMaxFrameLatency( frames );
+	}
+
+	void Win32Backend::BeginFrame()
+	{
+		// dragging the window edge sends WM_SIZE many times a frame, only the latest size counts
+		if (m_wnd->ShouldResize())
+		{
+			// false when the client area kept its size
+			const bool changed = m_wnd->Resize();
+			m_wnd->ResizeFinished();
+			if (changed)
+			{
+				m_resize.Request( m_wnd->GetWidth(), m_wnd->GetHeight() );
+			}
+		}
+		ResizeCoalescer::Size size;
+		if (m_resize.Poll( ExodusTimer::Now(), size ))
+		{
+			EXODUS_PROFILE_ZONE( "Resize" );
+			// the frame records without a back buffer until a retry succeeds
+			if (!DXContext::Get().Resize( size.width, size.height ))
+			{
+				m_resize.Retry();
+			}
+		}
+		DXContext::Get().InitCommandList();
+		m_imguiFrame = DXContext::Get().BeginImGuiFrame();
+		if (m_imguiFrame)
+		{
+			ImGui_ImplWin32_NewFrame();
+			ImGui::NewFrame();
+		}
+	}
+
+	void Win32Backend::EndFrame()
+	{
+		if (m_imguiFrame)
+		{
+			DXContext::Get().RenderImGui();
+		}
+		DXContext::Get().ExecuteCommandList();
+		// windows dragged out of the main one get their own swap chains
+		if (m_imguiFrame && (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable))
+		{
+			ImGui::UpdatePlatformWindows();
+			ImGui::RenderPlatformWindowsDefault();
+		}
+		m_imguiFrame = false;
+		DXContext::Get().Present();
+	}
+
+	bool Win32Backend::IsImGuiFrameOpen() const
+	{
+		return m_imguiFrame;
+	}
+}
@@ -0,0 +1,45 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include "PlatformBackend.h"
+#include "Windows/Window.h"
+#include "Support/ResizeCoalescer.h"
+
+namespace Exodus
+{
+	// Windowed backend, pumps the Win32 message queue and drives DXContext.
+	class Win32Backend : public PlatformBackend
+	{
+	public:
+		explicit Win32Backend( Window* wnd ) noexcept;
+		bool Init() override;
+		void Shutdown() override;
+		std::optional<int> ProcessMessages() override;
+		float WaitForFrame() override;
+		void SetMaxFrameLatency( uint32_t frames ) override;
+		void BeginFrame() override;
+		void EndFrame() override;
+		bool IsImGuiFrameOpen() const override;
+	private:
+		Window* m_wnd;
+		ResizeCoalescer m_resize;
+		bool m_imguiFrame = false;
+	};
+}
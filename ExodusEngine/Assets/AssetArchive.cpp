@@ -0,0 +1,375 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "AssetArchive.h"
+#include "Support/Lz4.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr size_t pageSize = 4096u;
+
+		char NormalizeChar( char c ) noexcept
+		{
+			if (c == '\\')
+			{
+				return '/';
+			}
+			return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+
+		uint32_t BucketOf( uint64_t hash, uint32_t bits ) noexcept
+		{
+			return bits == 0u ? 0u : static_cast<uint32_t>(hash >> (64u - bits));
+		}
+
+		uint64_t AlignUp( uint64_t value, uint64_t alignment ) noexcept
+		{
+			return (value + alignment - 1u) & ~(alignment - 1u);
+		}
+
+		bool ReadWholeFile( const std::string& path, std::vector<std::byte>& data )
+		{
+			std::ifstream file( path, std::ios::in | std::ios::binary | std::ios::ate );
+			if (!file)
+			{
+				return false;
+			}
+			const std::streamsize size = file.tellg();
+			if (size < 0)
+			{
+				return false;
+			}
+			data.resize( static_cast<size_t>(size) );
+			file.seekg( 0 );
+			return static_cast<bool>(file.read( reinterpret_cast<char*>(data.data()), size ));
+		}
+	}
+
+	bool AssetArchive::Open( const std::string& path )
+	{
+		Close();
+		if (!m_file.Open( path ))
+		{
+			return false;
+		}
+		const std::byte* base = m_file.GetData();
+		const uint64_t fileSize = m_file.GetSize();
+		const auto* header = reinterpret_cast<const ArchiveHeader*>(base);
+		// only the table bounds are checked here, entries are trusted like the rest of the content
+		const bool valid = fileSize >= sizeof( ArchiveHeader )
+			&& std::memcmp( header->tag, ArchiveHeader::magic, sizeof( header->tag ) ) == 0
+			&& header->version == ArchiveHeader::currentVersion
+			&& header->bucketBits < 32u
+			&& header->bucketOffset % alignof(uint32_t) == 0u
+			&& header->entryOffset % alignof(ArchiveEntry) == 0u
+			&& header->bucketOffset + ((uint64_t( 1u ) << header->bucketBits) + 1u) * sizeof( uint32_t ) <= fileSize
+			&& header->entryOffset + uint64_t( header->entryCount ) * sizeof( ArchiveEntry ) <= fileSize
+			&& header->pathOffset + header->pathSize <= fileSize;
+		if (!valid)
+		{
+			m_file.Close();
+			return false;
+		}
+		m_header = header;
+		m_buckets = reinterpret_cast<const uint32_t*>(base + header->bucketOffset);
+		m_entries = reinterpret_cast<const ArchiveEntry*>(base + header->entryOffset);
+		m_paths = reinterpret_cast<const char*>(base + header->pathOffset);
+		return true;
+	}
+
+	void AssetArchive::Close() noexcept
+	{
+		m_file.Close();
+		m_header = nullptr;
+		m_buckets = nullptr;
+		m_entries = nullptr;
+		m_paths = nullptr;
+	}
+
+	bool AssetArchive::IsOpen() const noexcept
+	{
+		return m_header != nullptr;
+	}
+
+	uint32_t AssetArchive::Find( std::string_view path ) const noexcept
+	{
+		if (!m_header)
+		{
+			return invalidEntry;
+		}
+		const uint64_t hash = HashPath( path );
+		const uint32_t bucket = BucketOf( hash, m_header->bucketBits );
+		for (uint32_t i = m_buckets[bucket]; i < m_buckets[bucket + 1u]; ++i)
+		{
+			const ArchiveEntry& entry = m_entries[i];
+			if (entry.hash > hash)
+			{
+				break;
+			}
+			if (entry.hash == hash && entry.pathLength == path.size()
+				&& std::equal( path.begin(), path.end(), m_paths + entry.pathOffset, []( char a, char b ) { return NormalizeChar( a ) == b; } ))
+			{
+				return i;
+			}
+		}
+		return invalidEntry;
+	}
+
+	uint32_t AssetArchive::GetEntryCount() const noexcept
+	{
+		return m_header ? m_header->entryCount : 0u;
+	}
+
+	std::string_view AssetArchive::GetPath( uint32_t entry ) const noexcept
+	{
+		const ArchiveEntry& e = GetEntry( entry );
+		return { m_paths + e.pathOffset, e.pathLength };
+	}
+
+	uint64_t AssetArchive::GetSize( uint32_t entry ) const noexcept
+	{
+		return GetEntry( entry ).size;
+	}
+
+	bool AssetArchive::IsCompressed( uint32_t entry ) const noexcept
+	{
+		return (GetEntry( entry ).flags & ArchiveEntry::Compressed) != 0u;
+	}
+
+	std::span<const std::byte> AssetArchive::GetStored( uint32_t entry ) const noexcept
+	{
+		const ArchiveEntry& e = GetEntry( entry );
+		if (e.flags & ArchiveEntry::Compressed)
+		{
+			return {};
+		}
+		return { m_file.GetData() + e.offset, static_cast<size_t>(e.storedSize) };
+	}
+
+	bool AssetArchive::Read( uint32_t entry, AssetData& data ) const
+	{
+		const ArchiveEntry& e = GetEntry( entry );
+		if (e.offset + e.storedSize > m_file.GetSize())
+		{
+			return false;
+		}
+		const std::byte* stored = m_file.GetData() + e.offset;
+		data.resize( static_cast<size_t>(e.size) );
+		if (e.flags & ArchiveEntry::Compressed)
+		{
+			return Lz4::Decompress( stored, static_cast<size_t>(e.storedSize), data.data(), data.size() );
+		}
+		std::copy( stored, stored + e.storedSize, data.data() );
+		return true;
+	}
+
+	void AssetArchive::Prefetch( uint32_t entry ) const noexcept
+	{
+		const ArchiveEntry& e = GetEntry( entry );
+		const volatile std::byte* data = m_file.GetData();
+		const uint64_t end = std::min<uint64_t>( e.offset + e.storedSize, m_file.GetSize() );
+		for (uint64_t offset = e.offset; offset < end; offset += pageSize)
+		{
+			static_cast<void>(data[offset]);
+		}
+	}
+
+	uint64_t AssetArchive::HashPath( std::string_view path ) noexcept
+	{
+		// FNV-1a over the normalized characters
+		uint64_t hash = 14695981039346656037ull;
+		for (const char c : path)
+		{
+			hash ^= static_cast<uint8_t>(NormalizeChar( c ));
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	std::string AssetArchive::NormalizePath( std::string_view path )
+	{
+		std::string normalized( path );
+		std::transform( normalized.begin(), normalized.end(), normalized.begin(), NormalizeChar );
+		return normalized;
+	}
+
+	const ArchiveEntry& AssetArchive::GetEntry( uint32_t entry ) const noexcept
+	{
+		return m_entries[entry];
+	}
+
+	AssetArchiveWriter::AssetArchiveWriter( uint32_t blobAlignment )
+		:
+		m_blobAlignment( blobAlignment )
+	{
+	}
+
+	bool AssetArchiveWriter::Add( std::string_view path, std::vector<std::byte> data, bool compress )
+	{
+		Pending pending;
+		pending.path = AssetArchive::NormalizePath( path );
+		pending.hash = AssetArchive::HashPath( pending.path );
+		pending.size = data.size();
+		pending.compressed = false;
+		// colliding hashes are fine, lookups compare the path as well
+		if (!m_paths.insert( pending.path ).second)
+		{
+			return false;
+		}
+		if (compress && !data.empty())
+		{
+			std::vector<std::byte> packed( Lz4::GetMaxCompressedSize( data.size() ) );
+			// only worth it when the saving outweighs the decompression
+			const size_t packedSize = Lz4::Compress( data.data(), data.size(), packed.data(), data.size() - data.size() / 16u );
+			if (packedSize != 0u)
+			{
+				packed.resize( packedSize );
+				packed.shrink_to_fit();
+				data = std::move( packed );
+				pending.compressed = true;
+			}
+		}
+		pending.data = std::move( data );
+		m_pending.push_back( std::move( pending ) );
+		return true;
+	}
+
+	bool AssetArchiveWriter::AddFile( std::string_view path, const std::string& sourceFile, bool compress )
+	{
+		std::vector<std::byte> data;
+		if (!ReadWholeFile( sourceFile, data ))
+		{
+			return false;
+		}
+		return Add( path, std::move( data ), compress );
+	}
+
+	bool AssetArchiveWriter::Write( const std::string& outputPath ) const
+	{
+		std::vector<const Pending*> sorted;
+		sorted.reserve( m_pending.size() );
+		for (const Pending& pending : m_pending)
+		{
+			sorted.push_back( &pending );
+		}
+		std::sort( sorted.begin(), sorted.end(), []( const Pending* a, const Pending* b ) { return a->hash < b->hash; } );
+
+		// about one entry per bucket keeps a lookup at a single probe on average
+		uint32_t bucketBits = 0u;
+		while ((size_t( 1u ) << bucketBits) < sorted.size())
+		{
+			++bucketBits;
+		}
+		const uint32_t bucketCount = 1u << bucketBits;
+
+		ArchiveHeader header = {};
+		std::memcpy( header.tag, ArchiveHeader::magic, sizeof( header.tag ) );
+		header.version = ArchiveHeader::currentVersion;
+		header.entryCount = static_cast<uint32_t>(sorted.size());
+		header.bucketBits = bucketBits;
+		header.blobAlignment = m_blobAlignment;
+		header.bucketOffset = sizeof( ArchiveHeader );
+		header.entryOffset = AlignUp( header.bucketOffset + (bucketCount + 1u) * sizeof( uint32_t ), alignof(ArchiveEntry) );
+		header.pathOffset = header.entryOffset + sorted.size() * sizeof( ArchiveEntry );
+
+		std::vector<uint32_t> buckets( bucketCount + 1u );
+		std::vector<ArchiveEntry> entries( sorted.size() );
+		std::string paths;
+		for (uint32_t b = 0u, i = 0u; b <= bucketCount; ++b)
+		{
+			while (i < sorted.size() && BucketOf( sorted[i]->hash, bucketBits ) < b)
+			{
+				++i;
+			}
+			buckets[b] = i;
+		}
+		buckets[bucketCount] = static_cast<uint32_t>(sorted.size());
+		for (size_t i = 0u; i < sorted.size(); ++i)
+		{
+			ArchiveEntry& entry = entries[i];
+			entry.hash = sorted[i]->hash;
+			entry.storedSize = sorted[i]->data.size();
+			entry.size = sorted[i]->size;
+			entry.pathOffset = static_cast<uint32_t>(paths.size());
+			entry.pathLength = static_cast<uint32_t>(sorted[i]->path.size());
+			entry.flags = sorted[i]->compressed ? ArchiveEntry::Compressed : 0u;
+			paths += sorted[i]->path;
+		}
+		header.pathSize = paths.size();
+		uint64_t offset = header.pathOffset + header.pathSize;
+		for (ArchiveEntry& entry : entries)
+		{
+			offset = AlignUp( offset, m_blobAlignment );
+			entry.offset = offset;
+			offset += entry.storedSize;
+		}
+
+		std::ofstream file( outputPath, std::ios::out | std::ios::binary | std::ios::trunc );
+		if (!file)
+		{
+			return false;
+		}
+		static constexpr char zeros[4096] = {};
+		uint64_t written = 0u;
+		const auto write = [&]( const void* data, uint64_t bytes )
+		{
+			file.write( static_cast<const char*>(data), static_cast<std::streamsize>(bytes) );
+			written += bytes;
+		};
+		const auto pad = [&]( uint64_t target )
+		{
+			while (written < target)
+			{
+				write( zeros, std::min<uint64_t>( target - written, sizeof( zeros ) ) );
+			}
+		};
+		write( &header, sizeof( header ) );
+		write( buckets.data(), buckets.size() * sizeof( uint32_t ) );
+		pad( header.entryOffset );
+		write( entries.data(), entries.size() * sizeof( ArchiveEntry ) );
+		write( paths.data(), paths.size() );
+		for (size_t i = 0u; i < sorted.size(); ++i)
+		{
+			pad( entries[i].offset );
+			write( sorted[i]->data.data(), sorted[i]->data.size() );
+		}
+		file.close();
+		return static_cast<bool>(file);
+	}
+
+	AssetArchiveWriter::Stats AssetArchiveWriter::GetStats() const noexcept
+	{
+		Stats stats;
+		stats.entryCount = m_pending.size();
+		for (const Pending& pending : m_pending)
+		{
+			stats.compressedCount += pending.compressed ? 1u : 0u;
+			stats.size += pending.size;
+			stats.storedSize += pending.data.size();
+		}
+		return stats;
+	}
+}
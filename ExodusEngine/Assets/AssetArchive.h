@@ -0,0 +1,149 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "AssetManager.h"
+#include "Support/MappedFile.h"
+
+namespace Exodus
+{
+	// On-disk layout of a packed archive, little-endian, read in place from the mapping:
+	//   ArchiveHeader   64 bytes
+	//   buckets         uint32 x (2^bucketBits + 1), first entry of each top-bits range of the hash
+	//   ArchiveEntry    x entryCount, sorted by path hash
+	//   paths           normalized paths, concatenated without terminators
+	//   blobs           each starting at a multiple of blobAlignment, LZ4 block data if compressed
+	// Paths are normalized to lower case with forward slashes, so lookups ignore both.
+	struct ArchiveHeader
+	{
+		static constexpr char magic[4] = { 'E', 'X', 'P', 'K' };
+		static constexpr uint32_t currentVersion = 1u;
+
+		char tag[4];
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t bucketBits;
+		uint32_t blobAlignment;
+		uint32_t reserved0;
+		uint64_t bucketOffset;
+		uint64_t entryOffset;
+		uint64_t pathOffset;
+		uint64_t pathSize;
+		uint64_t reserved1;
+	};
+	static_assert(sizeof( ArchiveHeader ) == 64u);
+
+	struct ArchiveEntry
+	{
+		enum Flags : uint32_t
+		{
+			Compressed = 1u,
+		};
+		uint64_t hash;
+		uint64_t offset;
+		uint64_t storedSize;
+		uint64_t size;
+		uint32_t pathOffset;
+		uint32_t pathLength;
+		uint32_t flags;
+		uint32_t reserved;
+	};
+	static_assert(sizeof( ArchiveEntry ) == 48u);
+
+	// Read-only view of a packed archive. Opening maps the file and checks the header, nothing
+	// is parsed up front; lookups hash the path and scan one bucket of the sorted table.
+	// Stored entries are served as spans into the mapping, compressed ones through Read().
+	class AssetArchive
+	{
+	public:
+		static constexpr uint32_t invalidEntry = ~0u;
+	public:
+		bool Open( const std::string& path );
+		void Close() noexcept;
+		bool IsOpen() const noexcept;
+
+		uint32_t Find( std::string_view path ) const noexcept;
+		uint32_t GetEntryCount() const noexcept;
+		std::string_view GetPath( uint32_t entry ) const noexcept;
+		// unpacked size
+		uint64_t GetSize( uint32_t entry ) const noexcept;
+		bool IsCompressed( uint32_t entry ) const noexcept;
+		// zero-copy, empty for compressed entries. Valid while the archive is open.
+		std::span<const std::byte> GetStored( uint32_t entry ) const noexcept;
+		// copies or decompresses the entry
+		bool Read( uint32_t entry, AssetData& data ) const;
+		// faults the entry's pages in on the calling thread, so first use doesn't stall on disk
+		void Prefetch( uint32_t entry ) const noexcept;
+
+		static uint64_t HashPath( std::string_view path ) noexcept;
+		static std::string NormalizePath( std::string_view path );
+	private:
+		const ArchiveEntry& GetEntry( uint32_t entry ) const noexcept;
+	private:
+		MappedFile m_file;
+		const ArchiveHeader* m_header = nullptr;
+		const uint32_t* m_buckets = nullptr;
+		const ArchiveEntry* m_entries = nullptr;
+		const char* m_paths = nullptr;
+	};
+
+	// Builds an archive in memory and writes it in one go, used by the ExodusPacker tool.
+	//   AssetArchiveWriter writer;
+	//   writer.AddFile( "Textures/Grass.dds", "Content/Textures/Grass.dds", true );
+	//   writer.Write( "Data/Base.pak" );
+	class AssetArchiveWriter
+	{
+	public:
+		struct Stats
+		{
+			size_t entryCount = 0u;
+			size_t compressedCount = 0u;
+			uint64_t size = 0u;
+			uint64_t storedSize = 0u;
+		};
+	private:
+		struct Pending
+		{
+			std::string path;
+			uint64_t hash;
+			uint64_t size;
+			bool compressed;
+			std::vector<std::byte> data;
+		};
+	public:
+		// blobAlignment must be a power of two
+		explicit AssetArchiveWriter( uint32_t blobAlignment = 64u );
+		// compress keeps the LZ4 version only when it is noticeably smaller, false for a duplicate path
+		bool Add( std::string_view path, std::vector<std::byte> data, bool compress );
+		bool AddFile( std::string_view path, const std::string& sourceFile, bool compress );
+		bool Write( const std::string& outputPath ) const;
+		Stats GetStats() const noexcept;
+	private:
+		uint32_t m_blobAlignment;
+		std::vector<Pending> m_pending;
+		std::unordered_set<std::string> m_paths;
+	};
+}
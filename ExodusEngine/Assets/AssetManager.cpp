@@ -0,0 +1,464 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "AssetManager.h"
+#include "AssetArchive.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace Exodus
+{
+	AssetManager::AssetManager( uint32_t ioThreadCount )
+	{
+		if (ioThreadCount == 0u)
+		{
+			ioThreadCount = 2u;
+		}
+		for (uint32_t i = 0u; i < ioThreadCount; ++i)
+		{
+			m_ioThreads.emplace_back( &AssetManager::IoLoop, this );
+		}
+	}
+
+	AssetManager::~AssetManager()
+	{
+		Shutdown();
+	}
+
+	bool AssetManager::MountArchive( const std::string& path )
+	{
+		auto archive = std::make_unique<AssetArchive>();
+		if (!archive->Open( path ))
+		{
+			return false;
+		}
+		m_archives.push_back( std::move( archive ) );
+		return true;
+	}
+
+	AssetHandle AssetManager::Load( const std::string& path, AssetPriority priority, AssetCallback callback )
+	{
+		std::string key = MakeKey( path );
+		if (const auto found = m_lookup.find( key ); found != m_lookup.end())
+		{
+			const uint32_t index = found->second;
+			Slot& slot = m_slots[index];
+			const AssetHandle handle = { index, slot.generation };
+			++slot.refCount;
+			switch (slot.state)
+			{
+			case AssetState::Queued:
+				if (callback)
+				{
+					slot.callbacks.push_back( std::move( callback ) );
+				}
+				if (priority > slot.priority)
+				{
+					SetPriority( handle, priority );
+				}
+				break;
+			case AssetState::Ready:
+				if (callback)
+				{
+					callback( handle, AssetState::Ready );
+				}
+				break;
+			default:
+				// failed or cancelled earlier, try again
+				slot.state = AssetState::Queued;
+				slot.priority = priority;
+				if (callback)
+				{
+					slot.callbacks.push_back( std::move( callback ) );
+				}
+				Enqueue( index );
+				break;
+			}
+			return handle;
+		}
+
+		uint32_t index;
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_slots.size());
+			m_slots.emplace_back();
+			std::lock_guard<std::mutex> lock( m_queueMutex );
+			m_tickets.push_back( 0u );
+		}
+		Slot& slot = m_slots[index];
+		slot.path = path;
+		slot.refCount = 1u;
+		slot.state = AssetState::Queued;
+		slot.priority = priority;
+		if (callback)
+		{
+			slot.callbacks.push_back( std::move( callback ) );
+		}
+		m_lookup.emplace( std::move( key ), index );
+		Enqueue( index );
+		return { index, slot.generation };
+	}
+
+	void AssetManager::SetPriority( AssetHandle handle, AssetPriority priority )
+	{
+		Slot* slot = Resolve( handle );
+		if (!slot || slot->state != AssetState::Queued || slot->priority == priority)
+		{
+			return;
+		}
+		// the old request is left in the queue and skipped for its stale ticket
+		slot->priority = priority;
+		Enqueue( handle.index );
+	}
+
+	void AssetManager::Cancel( AssetHandle handle )
+	{
+		Slot* slot = Resolve( handle );
+		if (!slot)
+		{
+			return;
+		}
+		Invalidate( handle.index );
+		slot->reloading = false;
+		if (slot->state == AssetState::Queued)
+		{
+			slot->state = AssetState::Cancelled;
+			Notify( handle.index, AssetState::Cancelled );
+		}
+	}
+
+	void AssetManager::Release( AssetHandle handle )
+	{
+		Slot* slot = Resolve( handle );
+		if (!slot || --slot->refCount > 0u)
+		{
+			return;
+		}
+		Invalidate( handle.index );
+		m_lookup.erase( MakeKey( slot->path ) );
+		slot->path.clear();
+		slot->reloading = false;
+		AssetData().swap( slot->data );
+		slot->view = {};
+		slot->callbacks.clear();
+		slot->state = AssetState::Invalid;
+		++slot->generation;
+		m_freeSlots.push_back( handle.index );
+	}
+
+	void AssetManager::Reload( AssetHandle handle )
+	{
+		Slot* slot = Resolve( handle );
+		if (!slot)
+		{
+			return;
+		}
+		if (slot->state == AssetState::Ready)
+		{
+			slot->reloading = true;
+		}
+		else
+		{
+			slot->state = AssetState::Queued;
+		}
+		Enqueue( handle.index );
+	}
+
+	void AssetManager::OnFilesChanged( std::span<const FileChange> changes )
+	{
+		for (const FileChange& change : changes)
+		{
+			if (change.type == FileChange::Type::Removed)
+			{
+				continue;
+			}
+			const std::string key = MakeKey( change.path );
+			if (change.type == FileChange::Type::Overflow)
+			{
+				const std::string prefix = key == "." ? std::string() : key + '/';
+				for (const auto& [path, index] : m_lookup)
+				{
+					if (path.compare( 0u, prefix.size(), prefix ) == 0)
+					{
+						Reload( { index, m_slots[index].generation } );
+					}
+				}
+			}
+			else if (const auto found = m_lookup.find( key ); found != m_lookup.end())
+			{
+				Reload( { found->second, m_slots[found->second].generation } );
+			}
+		}
+	}
+
+	void AssetManager::SetReloadCallback( AssetCallback callback )
+	{
+		m_reloadCallback = std::move( callback );
+	}
+
+	AssetState AssetManager::GetState( AssetHandle handle ) const noexcept
+	{
+		const Slot* slot = Resolve( handle );
+		return slot ? slot->state : AssetState::Invalid;
+	}
+
+	std::span<const std::byte> AssetManager::GetData( AssetHandle handle ) const noexcept
+	{
+		const Slot* slot = Resolve( handle );
+		if (!slot || slot->state != AssetState::Ready)
+		{
+			return {};
+		}
+		if (!slot->view.empty())
+		{
+			return slot->view;
+		}
+		return { slot->data.data(), slot->data.size() };
+	}
+
+	const std::string& AssetManager::GetPath( AssetHandle handle ) const noexcept
+	{
+		static const std::string none;
+		const Slot* slot = Resolve( handle );
+		return slot ? slot->path : none;
+	}
+
+	AssetHandle AssetManager::Find( const std::string& path ) const
+	{
+		const auto found = m_lookup.find( MakeKey( path ) );
+		if (found == m_lookup.end())
+		{
+			return {};
+		}
+		return { found->second, m_slots[found->second].generation };
+	}
+
+	AssetManager::Stats AssetManager::GetStats() const noexcept
+	{
+		Stats stats;
+		stats.slotCount = m_slots.size() - m_freeSlots.size();
+		for (const Slot& slot : m_slots)
+		{
+			stats.queuedCount += slot.state == AssetState::Queued ? 1u : 0u;
+			stats.readyCount += slot.state == AssetState::Ready ? 1u : 0u;
+		}
+		stats.bytesLoaded = m_bytesLoaded;
+		stats.filesLoaded = m_filesLoaded;
+		stats.filesFailed = m_filesFailed;
+		return stats;
+	}
+
+	void AssetManager::Update()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_completionMutex );
+			m_completions.swap( m_completionSwap );
+		}
+		for (Completion& completion : m_completionSwap)
+		{
+			// checked one by one, an earlier callback may have released or cancelled this one
+			if (m_tickets[completion.index] != completion.ticket)
+			{
+				continue;
+			}
+			Slot& slot = m_slots[completion.index];
+			const AssetHandle handle = { completion.index, slot.generation };
+			const bool reloaded = std::exchange( slot.reloading, false );
+			AssetState state = AssetState::Ready;
+			if (completion.succeeded)
+			{
+				m_bytesLoaded += completion.data.size() + completion.view.size();
+				++m_filesLoaded;
+				slot.data = std::move( completion.data );
+				slot.view = completion.view;
+				slot.state = AssetState::Ready;
+			}
+			else
+			{
+				++m_filesFailed;
+				// a failed reload keeps the data it had
+				if (slot.state != AssetState::Ready)
+				{
+					slot.state = AssetState::Failed;
+				}
+				state = AssetState::Failed;
+			}
+			Notify( completion.index, state );
+			if (reloaded && m_reloadCallback)
+			{
+				m_reloadCallback( handle, state );
+			}
+		}
+		m_completionSwap.clear();
+	}
+
+	void AssetManager::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_queueMutex );
+			m_running = false;
+		}
+		m_queueCondition.notify_all();
+		for (std::thread& thread : m_ioThreads)
+		{
+			thread.join();
+		}
+		m_ioThreads.clear();
+	}
+
+	AssetManager::Slot* AssetManager::Resolve( AssetHandle handle ) noexcept
+	{
+		if (handle.index >= m_slots.size())
+		{
+			return nullptr;
+		}
+		Slot& slot = m_slots[handle.index];
+		return slot.generation == handle.generation && slot.state != AssetState::Invalid ? &slot : nullptr;
+	}
+
+	const AssetManager::Slot* AssetManager::Resolve( AssetHandle handle ) const noexcept
+	{
+		return const_cast<AssetManager*>(this)->Resolve( handle );
+	}
+
+	void AssetManager::Enqueue( uint32_t index )
+	{
+		const Slot& slot = m_slots[index];
+		const AssetArchive* archive = nullptr;
+		uint32_t entry = AssetArchive::invalidEntry;
+		for (auto it = m_archives.rbegin(); it != m_archives.rend() && entry == AssetArchive::invalidEntry; ++it)
+		{
+			entry = (*it)->Find( slot.path );
+			archive = it->get();
+		}
+		if (entry == AssetArchive::invalidEntry)
+		{
+			archive = nullptr;
+		}
+		{
+			std::lock_guard<std::mutex> lock( m_queueMutex );
+			const uint32_t ticket = ++m_tickets[index];
+			m_requests.push( { slot.priority, m_nextSequence++, index, ticket, slot.path, archive, entry } );
+		}
+		m_queueCondition.notify_one();
+	}
+
+	void AssetManager::Invalidate( uint32_t index )
+	{
+		std::lock_guard<std::mutex> lock( m_queueMutex );
+		++m_tickets[index];
+	}
+
+	void AssetManager::Notify( uint32_t index, AssetState state )
+	{
+		Slot& slot = m_slots[index];
+		const AssetHandle handle = { index, slot.generation };
+		// moved out first, a callback may Load() again and queue new ones
+		std::vector<AssetCallback> callbacks = std::move( slot.callbacks );
+		slot.callbacks.clear();
+		for (AssetCallback& callback : callbacks)
+		{
+			callback( handle, state );
+		}
+	}
+
+	void AssetManager::IoLoop()
+	{
+		EXODUS_PROFILE_THREAD( "AssetIO" );
+		while (true)
+		{
+			Request request;
+			{
+				std::unique_lock<std::mutex> lock( m_queueMutex );
+				m_queueCondition.wait( lock, [this]() { return !m_running || !m_requests.empty(); } );
+				if (!m_running)
+				{
+					return;
+				}
+				request = m_requests.top();
+				m_requests.pop();
+				if (m_tickets[request.index] != request.ticket)
+				{
+					continue;
+				}
+			}
+			Completion completion;
+			completion.index = request.index;
+			completion.ticket = request.ticket;
+			completion.succeeded = false;
+			{
+				EXODUS_PROFILE_ZONE( "ReadAsset" );
+				if (!request.archive)
+				{
+					completion.succeeded = ReadFile( request.path, completion.data );
+				}
+				else if (request.archive->IsCompressed( request.entry ))
+				{
+					completion.succeeded = request.archive->Read( request.entry, completion.data );
+				}
+				else
+				{
+					// zero-copy, the page faults are taken here rather than on the main thread
+					completion.view = request.archive->GetStored( request.entry );
+					request.archive->Prefetch( request.entry );
+					completion.succeeded = true;
+				}
+			}
+			std::lock_guard<std::mutex> lock( m_completionMutex );
+			m_completions.push_back( std::move( completion ) );
+		}
+	}
+
+	std::string AssetManager::MakeKey( const std::string& path )
+	{
+		std::string key = std::filesystem::path( path ).lexically_normal().generic_string();
+#if defined(_WIN32)
+		// the file system ignores case
+		std::transform( key.begin(), key.end(), key.begin(), []( unsigned char c ) { return static_cast<char>(std::tolower( c )); } );
+#endif
+		return key;
+	}
+
+	bool AssetManager::ReadFile( const std::string& path, AssetData& data )
+	{
+		std::ifstream file( path, std::ios::in | std::ios::binary | std::ios::ate );
+		if (!file)
+		{
+			return false;
+		}
+		const std::streamsize size = file.tellg();
+		if (size < 0)
+		{
+			return false;
+		}
+		data.resize( static_cast<size_t>(size) );
+		file.seekg( 0 );
+		return static_cast<bool>(file.read( reinterpret_cast<char*>(data.data()), size ));
+	}
+}
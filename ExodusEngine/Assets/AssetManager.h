@@ -0,0 +1,207 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Memory/TrackedAllocator.h"
+#include "Support/FileWatcher.h"
+
+namespace Exodus
+{
+	// Reference to an asset slot. A released slot gets a new generation, so stale handles
+	// report AssetState::Invalid instead of seeing someone else's asset.
+	struct AssetHandle
+	{
+		uint32_t index = ~0u;
+		uint32_t generation = 0u;
+
+		bool IsValid() const noexcept
+		{
+			return index != ~0u;
+		}
+		bool operator==( const AssetHandle& ) const noexcept = default;
+	};
+
+	enum class AssetPriority : uint8_t
+	{
+		Low,
+		Normal,
+		High,
+		Critical,
+	};
+
+	enum class AssetState : uint8_t
+	{
+		Invalid,
+		Queued,
+		Ready,
+		Failed,
+		Cancelled,
+	};
+
+	using AssetData = std::vector<std::byte, TrackedAllocator<std::byte, MemoryTag::Assets>>;
+	using AssetCallback = std::function<void( AssetHandle handle, AssetState state )>;
+
+	class AssetArchive;
+
+	// Loads files on a small pool of dedicated I/O threads so blocking reads never stall the
+	// frame or the job system workers. Requests are served by priority, then in order.
+	// Results are handed over in Update(), which EngineApplication::Run() calls once per frame
+	// on the main thread; state, data and callbacks are only ever seen there.
+	// Loading the same path twice shares one slot, each Load() needs its own Release(). Paths are
+	// compared lexically normalized with forward slashes, the form FileWatcher reports them in.
+	//   const AssetHandle level = assets.Load( "Data/level.bin", AssetPriority::High,
+	//       [this]( AssetHandle h, AssetState state ) { OnLevelLoaded( h, state ); } );
+	class AssetManager
+	{
+	public:
+		struct Stats
+		{
+			size_t slotCount = 0u;
+			size_t queuedCount = 0u;
+			size_t readyCount = 0u;
+			uint64_t bytesLoaded = 0u;
+			uint64_t filesLoaded = 0u;
+			uint64_t filesFailed = 0u;
+		};
+	private:
+		struct Slot
+		{
+			std::string path;
+			uint32_t generation = 0u;
+			uint32_t refCount = 0u;
+			AssetState state = AssetState::Invalid;
+			AssetPriority priority = AssetPriority::Normal;
+			AssetData data;
+			// set instead of data for stored archive entries, points into the mapping
+			std::span<const std::byte> view;
+			std::vector<AssetCallback> callbacks;
+			// Ready data is being read again, reported to the reload callback
+			bool reloading = false;
+		};
+		struct Request
+		{
+			AssetPriority priority;
+			uint64_t sequence;
+			uint32_t index;
+			uint32_t ticket;
+			std::string path;
+			const AssetArchive* archive;
+			uint32_t entry;
+
+			bool operator<( const Request& other ) const noexcept
+			{
+				// std::priority_queue pops the largest, higher priority then lower sequence first
+				return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+			}
+		};
+		struct Completion
+		{
+			uint32_t index;
+			uint32_t ticket;
+			bool succeeded;
+			AssetData data;
+			std::span<const std::byte> view;
+		};
+	public:
+		// ioThreadCount 0 picks two, enough to keep an SSD busy without competing with the workers
+		explicit AssetManager( uint32_t ioThreadCount = 0u );
+		~AssetManager();
+		AssetManager( const AssetManager& ) = delete;
+		AssetManager& operator=( const AssetManager& ) = delete;
+
+		// paths found in a mounted archive are served from it instead of loose files, later
+		// mounts win. Mount before loading, archives stay mapped until the manager goes away.
+		bool MountArchive( const std::string& path );
+		// callback runs on the main thread from Update() once the read finished or failed,
+		// or right away when the asset is already loaded
+		AssetHandle Load( const std::string& path, AssetPriority priority = AssetPriority::Normal, AssetCallback callback = {} );
+		// reorders a queued request, no effect once it is loaded
+		void SetPriority( AssetHandle handle, AssetPriority priority );
+		// drops a queued request for every holder, callbacks get AssetState::Cancelled
+		void Cancel( AssetHandle handle );
+		// the last release frees the data and cancels a pending read
+		void Release( AssetHandle handle );
+		// reads the file again, the old data stays readable until the new one arrives
+		void Reload( AssetHandle handle );
+		// reloads the loaded assets whose files changed. Removed files keep their data,
+		// an overflow reloads everything below the directory.
+		void OnFilesChanged( std::span<const FileChange> changes );
+		// runs from Update() for every reload of Ready data, with AssetState::Failed when the new read failed
+		void SetReloadCallback( AssetCallback callback );
+
+		AssetState GetState( AssetHandle handle ) const noexcept;
+		// empty unless the state is Ready, valid until the asset is released or reloaded
+		std::span<const std::byte> GetData( AssetHandle handle ) const noexcept;
+		const std::string& GetPath( AssetHandle handle ) const noexcept;
+		AssetHandle Find( const std::string& path ) const;
+		Stats GetStats() const noexcept;
+
+		// delivers finished reads and their callbacks, main thread only
+		void Update();
+		void Shutdown();
+	private:
+		Slot* Resolve( AssetHandle handle ) noexcept;
+		const Slot* Resolve( AssetHandle handle ) const noexcept;
+		void Enqueue( uint32_t index );
+		void Invalidate( uint32_t index );
+		void Notify( uint32_t index, AssetState state );
+		void IoLoop();
+		static std::string MakeKey( const std::string& path );
+		static bool ReadFile( const std::string& path, AssetData& data );
+	private:
+		// deque so a callback can Load() without moving the slot being notified
+		std::deque<Slot> m_slots;
+		std::vector<uint32_t> m_freeSlots;
+		std::unordered_map<std::string, uint32_t> m_lookup;
+		std::vector<std::unique_ptr<AssetArchive>> m_archives;
+		AssetCallback m_reloadCallback;
+		uint64_t m_bytesLoaded = 0u;
+		uint64_t m_filesLoaded = 0u;
+		uint64_t m_filesFailed = 0u;
+
+		// guards the request queue and the tickets. A slot's ticket is bumped whenever its
+		// outstanding read stops being wanted, results carrying an old ticket are dropped.
+		// Only the main thread writes tickets, so it reads them without the lock.
+		std::mutex m_queueMutex;
+		std::vector<uint32_t> m_tickets;
+		std::condition_variable m_queueCondition;
+		std::priority_queue<Request> m_requests;
+		uint64_t m_nextSequence = 0u;
+		std::atomic<bool> m_running = true;
+		std::vector<std::thread> m_ioThreads;
+
+		std::mutex m_completionMutex;
+		std::vector<Completion> m_completions;
+		std::vector<Completion> m_completionSwap;
+	};
+}
@@ -0,0 +1,156 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "CommandListPool.h"
+
+#include <algorithm>
+
+namespace Exodus
+{
+	CommandListPool::CommandListPool( uint32_t maxLists, uint32_t maxAllocators )
+		:
+		m_lists( maxLists ),
+		m_maxAllocators( maxAllocators )
+	{
+	}
+
+	CommandListPool::Acquired CommandListPool::Acquire( uint64_t sortKey, uint64_t completedValue )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		while (!m_retired.empty() && m_retired.front().fenceValue <= completedValue)
+		{
+			m_freeAllocators.push_back( m_retired.front().allocator );
+			m_retired.pop_front();
+		}
+		const bool hasList = !m_freeLists.empty() || m_listsCreated < m_lists.size();
+		const bool hasAllocator = !m_freeAllocators.empty() || m_allocatorsCreated < m_maxAllocators;
+		if (!hasList || !hasAllocator)
+		{
+			return {};
+		}
+
+		Acquired acquired;
+		if (!m_freeLists.empty())
+		{
+			acquired.list = m_freeLists.back();
+			m_freeLists.pop_back();
+		}
+		else
+		{
+			acquired.list = m_listsCreated++;
+		}
+		if (!m_freeAllocators.empty())
+		{
+			acquired.allocator = m_freeAllocators.back();
+			m_freeAllocators.pop_back();
+		}
+		else
+		{
+			acquired.allocator = m_allocatorsCreated++;
+		}
+		ListSlot& slot = m_lists[acquired.list];
+		slot.state = ListState::Recording;
+		slot.allocator = acquired.allocator;
+		slot.sortKey = sortKey;
+		slot.sequence = m_sequence++;
+		return acquired;
+	}
+
+	void CommandListPool::Finish( uint32_t list )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if (list < m_listsCreated && m_lists[list].state == ListState::Recording)
+		{
+			m_lists[list].state = ListState::Finished;
+		}
+	}
+
+	void CommandListPool::Abandon( uint32_t list )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if (list < m_listsCreated && m_lists[list].state == ListState::Recording)
+		{
+			ListSlot& slot = m_lists[list];
+			m_freeAllocators.push_back( slot.allocator );
+			slot.state = ListState::Free;
+			slot.allocator = invalidIndex;
+			m_freeLists.push_back( list );
+		}
+	}
+
+	void CommandListPool::Submit( uint64_t fenceValue, std::vector<Submission>& submissions )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		const size_t first = submissions.size();
+		for (uint32_t i = 0u; i < m_listsCreated; ++i)
+		{
+			ListSlot& slot = m_lists[i];
+			if (slot.state != ListState::Finished)
+			{
+				continue;
+			}
+			submissions.push_back( { slot.sortKey, i } );
+			m_retired.push_back( { fenceValue, slot.allocator } );
+			slot.state = ListState::Free;
+			slot.allocator = invalidIndex;
+			m_freeLists.push_back( i );
+		}
+		std::sort( submissions.begin() + first, submissions.end(), [this]( const Submission& a, const Submission& b )
+			{
+				if (a.sortKey != b.sortKey)
+				{
+					return a.sortKey < b.sortKey;
+				}
+				return m_lists[a.list].sequence < m_lists[b.list].sequence;
+			} );
+	}
+
+	uint64_t CommandListPool::GetOldestFenceValue() const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		return m_retired.empty() ? 0u : m_retired.front().fenceValue;
+	}
+
+	CommandListPool::Stats CommandListPool::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		Stats stats;
+		stats.listsCreated = m_listsCreated;
+		stats.allocatorsCreated = m_allocatorsCreated;
+		stats.recording = static_cast<uint32_t>(std::count_if( m_lists.begin(), m_lists.begin() + m_listsCreated, []( const ListSlot& slot )
+			{
+				return slot.state == ListState::Recording;
+			} ));
+		stats.allocatorsInFlight = static_cast<uint32_t>(m_retired.size());
+		return stats;
+	}
+
+	void CommandListPool::Reset()
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		std::fill( m_lists.begin(), m_lists.end(), ListSlot{} );
+		m_listsCreated = 0u;
+		m_allocatorsCreated = 0u;
+		m_freeLists.clear();
+		m_freeAllocators.clear();
+		m_retired.clear();
+		m_sequence = 0u;
+	}
+}
@@ -0,0 +1,105 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Exodus
+{
+	// Index bookkeeping for command lists recorded on worker threads. Every Acquire() pairs a
+	// free list with an allocator no submission uses anymore. Lists are free again as soon as
+	// they were submitted, allocators only once the fence value they were submitted with has
+	// completed. The caller owns the objects and creates one the first time its index comes
+	// up, the pool never hands out more than the counts it was made with. Holds no graphics
+	// objects, like FrameRing. Acquire() and Finish() may be called from any thread.
+	class CommandListPool
+	{
+	public:
+		static constexpr uint32_t invalidIndex = ~0u;
+		struct Acquired
+		{
+			uint32_t list = invalidIndex;
+			uint32_t allocator = invalidIndex;
+		};
+		struct Submission
+		{
+			uint64_t sortKey;
+			uint32_t list;
+		};
+		struct Stats
+		{
+			uint32_t listsCreated = 0u;
+			uint32_t allocatorsCreated = 0u;
+			uint32_t recording = 0u;
+			uint32_t allocatorsInFlight = 0u;
+		};
+	private:
+		enum class ListState : uint8_t
+		{
+			Free,
+			Recording,
+			Finished,
+		};
+		struct ListSlot
+		{
+			ListState state = ListState::Free;
+			uint32_t allocator = invalidIndex;
+			uint64_t sortKey = 0u;
+			// acquisition order, breaks ties between equal sort keys
+			uint64_t sequence = 0u;
+		};
+		struct Retired
+		{
+			uint64_t fenceValue;
+			uint32_t allocator;
+		};
+	public:
+		CommandListPool( uint32_t maxLists, uint32_t maxAllocators );
+		// Invalid when every list is taken or every allocator is still in flight. In the latter
+		// case waiting for GetOldestFenceValue() frees one up.
+		Acquired Acquire( uint64_t sortKey, uint64_t completedValue );
+		// the list has been closed and goes out with the next Submit()
+		void Finish( uint32_t list );
+		// gives back a list that won't be recorded after all, with its allocator: it was never
+		// submitted, so both are free again straight away
+		void Abandon( uint32_t list );
+		// Appends the lists finished since the last call ordered by sort key, equal keys in the
+		// order they were acquired. Their allocators are tagged with fenceValue. Lists still
+		// recording stay for a later call.
+		void Submit( uint64_t fenceValue, std::vector<Submission>& submissions );
+		// fence value of the oldest allocator in flight, 0 when there is none
+		uint64_t GetOldestFenceValue() const;
+		Stats GetStats() const;
+		// drops everything, only when the GPU is idle and no list is recording
+		void Reset();
+	private:
+		mutable std::mutex m_mutex;
+		std::vector<ListSlot> m_lists;
+		uint32_t m_maxAllocators;
+		uint32_t m_listsCreated = 0u;
+		uint32_t m_allocatorsCreated = 0u;
+		std::vector<uint32_t> m_freeLists;
+		std::vector<uint32_t> m_freeAllocators;
+		std::deque<Retired> m_retired;
+		uint64_t m_sequence = 0u;
+	};
+}
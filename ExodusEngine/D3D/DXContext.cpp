@@ -20,6 +20,17 @@
 #include "exopch.h"
 #include "DXContext.h"
 #include "ExodusException.h"
+#include "ExodusTimer.h"
+#include "Profiling/Profiler.h"
+#include "Memory/MemoryTracker.h"
+
+// imgui
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_dx12.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace Exodus
 {
@@ -82,20 +93,52 @@ namespace Exodus
 				return false;
 			}
 
-			if (FAILED( m_device->CreateCommandAllocator( D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS( &m_cmdAllocator ) ) ))
+			// one allocator per frame in flight, so recording a frame never resets memory the gpu still reads
+			for (int32_t i = 0; i < m_framesInFlight; ++i)
 			{
-				return false;
+				if (FAILED( m_device->CreateCommandAllocator( D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS( &m_cmdAllocators[i] ) ) ))
+				{
+					return false;
+				}
 			}
+			m_frameRing.Reset();
 
 			if (FAILED( m_device->CreateCommandList1( 0, D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS( &m_cmdList ) ) ))
 			{
 				return false;
 			}		
+
+			if (!CreateUploadQueue())
+			{
+				return false;
+			}
+
+			if (!CreateDescriptorHeap( m_resourceHeap, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_resourceDescriptors, m_frameResourceDescriptors ) ||
+				!CreateDescriptorHeap( m_samplerHeap, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, m_samplerDescriptors, m_frameSamplerDescriptors ))
+			{
+				return false;
+			}
+
+			D3D12_DESCRIPTOR_HEAP_DESC rtvDesc = {};
+			rtvDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+			rtvDesc.NumDescriptors = m_bufferCount;
+			if (FAILED( m_device->CreateDescriptorHeap( &rtvDesc, IID_PPV_ARGS( &m_rtvHeap ) ) ))
+			{
+				return false;
+			}
+			m_rtvIncrement = m_device->GetDescriptorHandleIncrementSize( D3D12_DESCRIPTOR_HEAP_TYPE_RTV );
 		
 			if (!CreateSwapChain( wnd ))
 			{
 				return false;
 			}
+
+			// the window set up the ImGui context, its font texture lives in the resource heap
+			if (ImGui::GetCurrentContext())
+			{
+				const Descriptor font = AllocateDescriptor( D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV );
+				m_imguiInit = ImGui_ImplDX12_Init( m_device, m_framesInFlight, DXGI_FORMAT_R8G8B8A8_UNORM, m_resourceHeap.heap, font.cpu, font.gpu );
+			}
 		}
 		return true;
 	}
@@ -103,7 +146,17 @@ namespace Exodus
 	void DXContext::Shutdown()
 	{
 		Flush();
+		m_releaseQueue.ReleaseAll();
+		if (m_imguiInit)
+		{
+			ImGui_ImplDX12_Shutdown();
+			m_imguiInit = false;
+		}
 		ReleaseBuffers();
+		if (m_rtvHeap)
+		{
+			m_rtvHeap.Release();
+		}
 		if (m_factory)
 		{
 			m_factory.Release();
@@ -116,9 +169,60 @@ namespace Exodus
 		{
 			m_cmdList.Release();
 		}		
-		if (m_cmdAllocator)
+		if (m_uploadBuffer)
+		{
+			m_uploadBuffer->Unmap( 0, nullptr );
+			m_uploadData = nullptr;
+			m_uploadBuffer.Release();
+			MemoryTracker::Get().OnFree( MemoryTag::GpuUpload, m_uploadRingSize );
+		}
+		if (m_copyList)
+		{
+			m_copyList.Release();
+		}
+		for (ComPointer<ID3D12GraphicsCommandList10>& list : m_recordingLists)
+		{
+			list.Release();
+		}
+		for (ComPointer<ID3D12CommandAllocator>& allocator : m_recordingAllocators)
 		{
-			m_cmdAllocator.Release();
+			allocator.Release();
+		}
+		m_listPool.Reset();
+		for (DescriptorHeap* heap : { &m_resourceHeap, &m_samplerHeap })
+		{
+			if (heap->heap)
+			{
+				heap->heap.Release();
+			}
+			heap->allocator.Reset( 0u, 0u );
+		}
+		for (int32_t i = 0; i < m_framesInFlight; ++i)
+		{
+			if (m_copyAllocators[i])
+			{
+				m_copyAllocators[i].Release();
+			}
+		}
+		if (m_copyFence)
+		{
+			m_copyFence.Release();
+		}
+		if (m_copyQueue)
+		{
+			m_copyQueue.Release();
+		}
+		for (int32_t i = 0; i < m_framesInFlight; ++i)
+		{
+			if (m_cmdAllocators[i])
+			{
+				m_cmdAllocators[i].Release();
+			}
+		}
+		if (m_frameLatencyWaitable)
+		{
+			CloseHandle( m_frameLatencyWaitable );
+			m_frameLatencyWaitable = nullptr;
 		}
 		if (m_fenceEvent)
 		{
@@ -142,13 +246,28 @@ namespace Exodus
 	void DXContext::SignalAndWait()
 	{
 		m_cmdQueue->Signal( m_fence, ++m_fenceValue );
-		if (SUCCEEDED( m_fence->SetEventOnCompletion( m_fenceValue, m_fenceEvent ) ))
+		WaitForFenceValue( m_fenceValue );
+	}
+
+	void DXContext::WaitForFenceValue( UINT64 fenceValue )
+	{
+		WaitForFenceValue( m_fence, fenceValue );
+	}
+
+	void DXContext::WaitForFenceValue( ID3D12Fence1* fence, UINT64 fenceValue )
+	{
+		if (fence->GetCompletedValue() >= fenceValue)
+		{
+			return;
+		}
+		EXODUS_PROFILE_ZONE( "FenceWait" );
+		if (SUCCEEDED( fence->SetEventOnCompletion( fenceValue, m_fenceEvent ) ))
 		{
 			if (WaitForSingleObject( m_fenceEvent, 20000 ) != WAIT_OBJECT_0)
 			{
 				std::exit( -1 );
 			}
-		}	
+		}
 		else
 		{
 			std::exit( -1 );
@@ -157,23 +276,158 @@ namespace Exodus
 
 	ID3D12GraphicsCommandList10* DXContext::InitCommandList()
 	{
-		m_cmdAllocator->Reset();
-		m_cmdList->Reset( m_cmdAllocator, nullptr );
+		EXODUS_PROFILE_FUNCTION();
+		// only block on the frame that last used this slot, the others may still be in flight
+		if (m_frameRing.NeedsWait( m_fence->GetCompletedValue() ))
+		{
+			WaitForFenceValue( m_frameRing.GetWaitValue() );
+		}
+		ComPointer<ID3D12CommandAllocator>& allocator = m_cmdAllocators[m_frameRing.GetCurrentSlot()];
+		allocator->Reset();
+		m_cmdList->Reset( allocator, nullptr );
+		const UINT64 completed = m_fence->GetCompletedValue();
+		m_resourceHeap.allocator.Reclaim( completed );
+		m_samplerHeap.allocator.Reclaim( completed );
+		m_releaseQueue.Release( completed );
+		ID3D12DescriptorHeap* heaps[] = { m_resourceHeap.heap, m_samplerHeap.heap };
+		m_cmdList->SetDescriptorHeaps( 2, heaps );
+		// no back buffers after a failed resize, the frame then records without a target
+		const UINT backBuffer = m_swapChain->GetCurrentBackBufferIndex();
+		if (m_buffers[backBuffer])
+		{
+			m_boundBackBuffer = backBuffer;
+			TransitionBackBuffer( D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET );
+			D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+			rtv.ptr += SIZE_T( backBuffer ) * m_rtvIncrement;
+			const float clearColor[] = { 0.1f, 0.1f, 0.1f, 1.0f };
+			m_cmdList->ClearRenderTargetView( rtv, clearColor, 0, nullptr );
+			m_cmdList->OMSetRenderTargets( 1, &rtv, FALSE, nullptr );
+		}
 		return m_cmdList;
 	}
 
 	void DXContext::ExecuteCommandList()
 	{
-		if (SUCCEEDED( m_cmdList->Close() ))
+		EXODUS_PROFILE_FUNCTION();
+		SubmitUploads();
+		if (m_copyFenceValue > m_copyWaitValue)
 		{
-			ID3D12CommandList* lists[] = { m_cmdList };
-			m_cmdQueue->ExecuteCommandLists( 1, lists );
-			SignalAndWait();
+			// a GPU side wait, the frame's commands see the uploads without the CPU blocking
+			m_cmdQueue->Wait( m_copyFence, m_copyFenceValue );
+			m_copyWaitValue = m_copyFenceValue;
+		}
+		if (m_boundBackBuffer != m_noBackBuffer)
+		{
+			TransitionBackBuffer( D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT );
+			m_boundBackBuffer = m_noBackBuffer;
+		}
+		// the worker lists and the frame list go out in one call, in sort key order
+		const bool frameListClosed = SUCCEEDED( m_cmdList->Close() );
+		m_submissions.clear();
+		m_listPool.Submit( m_fenceValue + 1u, m_submissions );
+		m_executeLists.clear();
+		bool frameListAdded = !frameListClosed;
+		for (const CommandListPool::Submission& submission : m_submissions)
+		{
+			if (!frameListAdded && submission.sortKey >= frameListSortKey)
+			{
+				m_executeLists.push_back( m_cmdList );
+				frameListAdded = true;
+			}
+			m_executeLists.push_back( m_recordingLists[submission.list] );
+		}
+		if (!frameListAdded)
+		{
+			m_executeLists.push_back( m_cmdList );
+		}
+		if (!m_executeLists.empty())
+		{
+			m_cmdQueue->ExecuteCommandLists( static_cast<UINT>(m_executeLists.size()), m_executeLists.data() );
+			m_cmdQueue->Signal( m_fence, ++m_fenceValue );
+			m_frameRing.MarkSubmitted( m_fenceValue );
+			m_resourceHeap.allocator.MarkSubmitted( m_fenceValue );
+			m_samplerHeap.allocator.MarkSubmitted( m_fenceValue );
+			m_frameRing.Advance();
 		}	
 	}
 
+	DXContext::RecordingList DXContext::AcquireCommandList( uint64_t sortKey )
+	{
+		EXODUS_PROFILE_FUNCTION();
+		CommandListPool::Acquired acquired = m_listPool.Acquire( sortKey, m_fence->GetCompletedValue() );
+		while (acquired.list == CommandListPool::invalidIndex)
+		{
+			const UINT64 oldest = m_listPool.GetOldestFenceValue();
+			if (oldest == 0u)
+			{
+				// every list is recording
+				return {};
+			}
+			// any thread may get here, a null event blocks without sharing m_fenceEvent
+			EXODUS_PROFILE_ZONE( "FenceWait" );
+			if (FAILED( m_fence->SetEventOnCompletion( oldest, nullptr ) ))
+			{
+				// device removed, the fence won't get there
+				return {};
+			}
+			acquired = m_listPool.Acquire( sortKey, m_fence->GetCompletedValue() );
+		}
+
+		// this runs on worker threads, where an exception would end the process, so a
+		// failure hands the slots back and returns an empty recording instead
+		ComPointer<ID3D12CommandAllocator>& allocator = m_recordingAllocators[acquired.allocator];
+		ComPointer<ID3D12GraphicsCommandList10>& list = m_recordingLists[acquired.list];
+		bool ready = allocator
+			? SUCCEEDED( allocator->Reset() )
+			: SUCCEEDED( m_device->CreateCommandAllocator( D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS( &allocator ) ) );
+		if (ready && !list)
+		{
+			// created closed, the reset below opens it on this allocator
+			ready = SUCCEEDED( m_device->CreateCommandList1( 0, D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS( &list ) ) );
+		}
+		if (!ready || FAILED( list->Reset( allocator, nullptr ) ))
+		{
+			m_listPool.Abandon( acquired.list );
+			return {};
+		}
+		ID3D12DescriptorHeap* heaps[] = { m_resourceHeap.heap, m_samplerHeap.heap };
+		list->SetDescriptorHeaps( 2, heaps );
+		return { list, acquired.list };
+	}
+
+	void DXContext::FinishCommandList( RecordingList& recording )
+	{
+		if (recording.list)
+		{
+			recording.list->Close();
+			m_listPool.Finish( recording.index );
+			recording = {};
+		}
+	}
+
+	bool DXContext::BeginImGuiFrame()
+	{
+		if (!m_imguiInit)
+		{
+			return false;
+		}
+		ImGui_ImplDX12_NewFrame();
+		return true;
+	}
+
+	void DXContext::RenderImGui()
+	{
+		EXODUS_PROFILE_FUNCTION();
+		ImGui::Render();
+		if (m_boundBackBuffer != m_noBackBuffer)
+		{
+			ImGui_ImplDX12_RenderDrawData( ImGui::GetDrawData(), m_cmdList );
+		}
+	}
+
 	void DXContext::Present()
 	{
+		EXODUS_PROFILE_FUNCTION();
 		UINT syncInterval = _VSync ? 1 : 0;
 		UINT presentFlags = _TearingSupported && !_VSync ? DXGI_PRESENT_ALLOW_TEARING : 0;
 		ThrowIfFailed( m_swapChain->Present( syncInterval, presentFlags ) );
@@ -186,24 +440,302 @@ namespace Exodus
 
 	void DXContext::Flush()
 	{
+		EXODUS_PROFILE_FUNCTION();
 		for (int32_t i = 0; i < m_bufferCount; i++)
 		{
 			SignalAndWait();
 		}		
+		if (m_copyFence)
+		{
+			WaitForFenceValue( m_copyFence, SubmitUploads() );
+		}
+	}
+
+	bool DXContext::Resize( UINT width, UINT height )
+	{
+		EXODUS_PROFILE_FUNCTION();
+		// ResizeBuffers() needs every reference to the back buffers gone, so only the last frame
+		// that rendered to them is waited for: the command queue runs in order, so that covers
+		// every frame before it. They are released right here, not through the release queue,
+		// whose pending entries must not decide whether the resize works. The copy queue keeps going.
+		WaitForFenceValue( m_frameRing.GetLastSubmittedValue() );
+		ReleaseBuffers();
+		if (FAILED( m_swapChain->ResizeBuffers( m_bufferCount, width, height, DXGI_FORMAT_UNKNOWN, GetSwapChainFlags() ) ))
+		{
+			return false;
+		}
+		return GetBuffers();
+	}
+
+	void DXContext::SetMaxFrameLatency( UINT frames )
+	{
+		m_maxFrameLatency = frames;
+		if (m_frameLatencyWaitable && frames > 0)
+		{
+			m_swapChain->SetMaximumFrameLatency( frames );
+		}
 	}
 
-	bool DXContext::Resize( Window* wnd )
-	{		
-		if (wnd->Resize())
+	float DXContext::WaitForFrameLatency()
+	{
+		if (!m_frameLatencyWaitable || m_maxFrameLatency == 0)
+		{
+			return 0.0f;
+		}
+		EXODUS_PROFILE_FUNCTION();
+		const ExodusTimer timer;
+		// bounded so a lost device doesn't hang the frame loop
+		WaitForSingleObjectEx( m_frameLatencyWaitable, 1000, TRUE );
+		return timer.Peek();
+	}
+
+	bool DXContext::UploadBuffer( ID3D12Resource* destination, UINT64 destinationOffset, const void* data, UINT64 size )
+	{
+		// in pieces, so a large buffer never needs the whole ring to itself
+		const UINT64 chunkSize = m_uploadRing.GetCapacity() / 4u;
+		const auto* source = static_cast<const std::byte*>(data);
+		for (UINT64 done = 0u; done < size;)
+		{
+			const UINT64 count = std::min( size - done, chunkSize );
+			const UINT64 offset = AllocateUpload( count, 16u );
+			if (offset == UploadRing::invalidOffset)
+			{
+				return false;
+			}
+			std::memcpy( m_uploadData + offset, source + done, count );
+			GetCopyList()->CopyBufferRegion( destination, destinationOffset + done, m_uploadBuffer, offset, count );
+			done += count;
+		}
+		return true;
+	}
+
+	bool DXContext::UploadTexture( ID3D12Resource* destination, UINT firstSubresource, UINT subresourceCount, const D3D12_SUBRESOURCE_DATA* subresources )
+	{
+		const D3D12_RESOURCE_DESC desc = destination->GetDesc();
+		std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts( subresourceCount );
+		std::vector<UINT> rowCounts( subresourceCount );
+		std::vector<UINT64> rowSizes( subresourceCount );
+		UINT64 totalSize = 0u;
+		m_device->GetCopyableFootprints( &desc, firstSubresource, subresourceCount, 0u, layouts.data(), rowCounts.data(), rowSizes.data(), &totalSize );
+		const UINT64 offset = AllocateUpload( totalSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT );
+		if (offset == UploadRing::invalidOffset)
+		{
+			return false;
+		}
+		ID3D12GraphicsCommandList10* list = GetCopyList();
+		for (UINT i = 0u; i < subresourceCount; ++i)
+		{
+			const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[i];
+			const D3D12_SUBRESOURCE_DATA& source = subresources[i];
+			std::byte* target = m_uploadData + offset + layout.Offset;
+			// the staged rows use the footprint's aligned pitch
+			const UINT64 slicePitch = UINT64( layout.Footprint.RowPitch ) * rowCounts[i];
+			for (UINT z = 0u; z < layout.Footprint.Depth; ++z)
+			{
+				for (UINT row = 0u; row < rowCounts[i]; ++row)
+				{
+					std::memcpy( target + z * slicePitch + row * UINT64( layout.Footprint.RowPitch ),
+						static_cast<const std::byte*>(source.pData) + z * source.SlicePitch + row * source.RowPitch, rowSizes[i] );
+				}
+			}
+			D3D12_TEXTURE_COPY_LOCATION dst = {};
+			dst.pResource = destination;
+			dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+			dst.SubresourceIndex = firstSubresource + i;
+			D3D12_TEXTURE_COPY_LOCATION src = {};
+			src.pResource = m_uploadBuffer;
+			src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			src.PlacedFootprint = layout;
+			src.PlacedFootprint.Offset += offset;
+			list->CopyTextureRegion( &dst, 0, 0, 0, &src, nullptr );
+		}
+		return true;
+	}
+
+	UINT64 DXContext::SubmitUploads()
+	{
+		if (!m_copyListOpen)
+		{
+			return m_copyFenceValue;
+		}
+		EXODUS_PROFILE_FUNCTION();
+		m_copyListOpen = false;
+		if (SUCCEEDED( m_copyList->Close() ))
+		{
+			ID3D12CommandList* lists[] = { m_copyList };
+			m_copyQueue->ExecuteCommandLists( 1, lists );
+		}
+		m_copyQueue->Signal( m_copyFence, ++m_copyFenceValue );
+		m_uploadRing.MarkSubmitted( m_copyFenceValue );
+		m_copyRing.MarkSubmitted( m_copyFenceValue );
+		m_copyRing.Advance();
+		return m_copyFenceValue;
+	}
+
+	DXContext::Descriptor DXContext::AllocateDescriptor( D3D12_DESCRIPTOR_HEAP_TYPE type )
+	{
+		DescriptorHeap& heap = GetHeap( type );
+		return GetDescriptor( heap, heap.allocator.AllocatePersistent() );
+	}
+
+	void DXContext::FreeDescriptor( D3D12_DESCRIPTOR_HEAP_TYPE type, UINT index )
+	{
+		GetHeap( type ).allocator.FreePersistent( index );
+	}
+
+	DXContext::Descriptor DXContext::AllocateFrameDescriptors( D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count )
+	{
+		DescriptorHeap& heap = GetHeap( type );
+		UINT index;
+		while ((index = heap.allocator.AllocateTransient( count )) == DescriptorAllocator::invalidIndex)
+		{
+			// nothing older to wait for, this frame alone asks for more than the region holds
+			const UINT64 oldest = heap.allocator.GetOldestFenceValue();
+			if (oldest == 0u)
+			{
+				return {};
+			}
+			WaitForFenceValue( oldest );
+			heap.allocator.Reclaim( m_fence->GetCompletedValue() );
+		}
+		return GetDescriptor( heap, index );
+	}
+
+	ID3D12DescriptorHeap* DXContext::GetDescriptorHeap( D3D12_DESCRIPTOR_HEAP_TYPE type )
+	{
+		return GetHeap( type ).heap;
+	}
+
+	bool DXContext::CreateDescriptorHeap( DescriptorHeap& heap, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT persistentCount, UINT transientCount )
+	{
+		D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+		desc.Type = type;
+		desc.NumDescriptors = persistentCount + transientCount;
+		desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		desc.NodeMask = 0;
+		if (FAILED( m_device->CreateDescriptorHeap( &desc, IID_PPV_ARGS( &heap.heap ) ) ))
+		{
+			return false;
+		}
+		heap.increment = m_device->GetDescriptorHandleIncrementSize( type );
+		heap.cpuStart = heap.heap->GetCPUDescriptorHandleForHeapStart();
+		heap.gpuStart = heap.heap->GetGPUDescriptorHandleForHeapStart();
+		heap.allocator.Reset( persistentCount, transientCount );
+		return true;
+	}
+
+	DXContext::DescriptorHeap& DXContext::GetHeap( D3D12_DESCRIPTOR_HEAP_TYPE type )
+	{
+		return type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? m_samplerHeap : m_resourceHeap;
+	}
+
+	DXContext::Descriptor DXContext::GetDescriptor( const DescriptorHeap& heap, UINT index ) const
+	{
+		Descriptor descriptor;
+		if (index == DescriptorAllocator::invalidIndex)
+		{
+			return descriptor;
+		}
+		descriptor.index = index;
+		descriptor.cpu.ptr = heap.cpuStart.ptr + SIZE_T( index ) * heap.increment;
+		descriptor.gpu.ptr = heap.gpuStart.ptr + UINT64( index ) * heap.increment;
+		return descriptor;
+	}
+
+	bool DXContext::CreateUploadQueue()
+	{
+		D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+		queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+		queueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+		queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+		queueDesc.NodeMask = 0;
+		if (FAILED( m_device->CreateCommandQueue( &queueDesc, IID_PPV_ARGS( &m_copyQueue ) ) ))
+		{
+			return false;
+		}
+		if (FAILED( m_device->CreateFence( m_copyFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS( &m_copyFence ) ) ))
+		{
+			return false;
+		}
+		for (int32_t i = 0; i < m_framesInFlight; ++i)
+		{
+			if (FAILED( m_device->CreateCommandAllocator( D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS( &m_copyAllocators[i] ) ) ))
+			{
+				return false;
+			}
+		}
+		m_copyRing.Reset();
+		if (FAILED( m_device->CreateCommandList1( 0, D3D12_COMMAND_LIST_TYPE_COPY, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS( &m_copyList ) ) ))
+		{
+			return false;
+		}
+
+		D3D12_HEAP_PROPERTIES heap = {};
+		heap.Type = D3D12_HEAP_TYPE_UPLOAD;
+		D3D12_RESOURCE_DESC bufferDesc = {};
+		bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+		bufferDesc.Width = m_uploadRingSize;
+		bufferDesc.Height = 1;
+		bufferDesc.DepthOrArraySize = 1;
+		bufferDesc.MipLevels = 1;
+		bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+		bufferDesc.SampleDesc = { 1, 0 };
+		bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+		bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+		if (FAILED( m_device->CreateCommittedResource( &heap, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS( &m_uploadBuffer ) ) ))
 		{
-			ReleaseBuffers();
-			Flush();
-			m_swapChain->ResizeBuffers( m_bufferCount, wnd->GetWidth(), wnd->GetHeight(), DXGI_FORMAT_UNKNOWN, CheckTearingSupport() ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING | DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH : DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH );
-			wnd->ResizeFinished();
-			GetBuffers();
-			return true;
+			return false;
 		}
-		return false;
+		// mapped for the buffer's whole life, the CPU only writes it (write-combined memory)
+		const D3D12_RANGE noRead = { 0, 0 };
+		void* data = nullptr;
+		if (FAILED( m_uploadBuffer->Map( 0, &noRead, &data ) ))
+		{
+			return false;
+		}
+		m_uploadData = static_cast<std::byte*>(data);
+		m_uploadRing.Reset( m_uploadRingSize );
+		MemoryTracker::Get().OnAllocate( MemoryTag::GpuUpload, m_uploadRingSize );
+		return true;
+	}
+
+	UINT64 DXContext::AllocateUpload( UINT64 size, UINT64 alignment )
+	{
+		m_uploadRing.Reclaim( m_copyFence->GetCompletedValue() );
+		UINT64 offset;
+		while ((offset = m_uploadRing.Allocate( size, alignment )) == UploadRing::invalidOffset)
+		{
+			if (size > m_uploadRing.GetCapacity())
+			{
+				return UploadRing::invalidOffset;
+			}
+			EXODUS_PROFILE_ZONE( "UploadRingFull" );
+			if (m_uploadRing.GetOldestFenceValue() == 0u)
+			{
+				// full of copies that were never submitted
+				SubmitUploads();
+			}
+			WaitForFenceValue( m_copyFence, m_uploadRing.GetOldestFenceValue() );
+			m_uploadRing.Reclaim( m_copyFence->GetCompletedValue() );
+		}
+		return offset;
+	}
+
+	ID3D12GraphicsCommandList10* DXContext::GetCopyList()
+	{
+		if (!m_copyListOpen)
+		{
+			// same scheme as the direct list, only the allocator the copy queue may still read waits
+			if (m_copyRing.NeedsWait( m_copyFence->GetCompletedValue() ))
+			{
+				WaitForFenceValue( m_copyFence, m_copyRing.GetWaitValue() );
+			}
+			ComPointer<ID3D12CommandAllocator>& allocator = m_copyAllocators[m_copyRing.GetCurrentSlot()];
+			allocator->Reset();
+			m_copyList->Reset( allocator, nullptr );
+			m_copyListOpen = true;
+		}
+		return m_copyList;
 	}
 
 	bool DXContext::GetBuffers()
@@ -214,11 +746,24 @@ namespace Exodus
 			{
 				return false;
 			}
-			
+			D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+			rtv.ptr += SIZE_T( i ) * m_rtvIncrement;
+			m_device->CreateRenderTargetView( m_buffers[i], nullptr, rtv );
 		}
 		return true;
 	}
 
+	void DXContext::TransitionBackBuffer( D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after )
+	{
+		D3D12_RESOURCE_BARRIER barrier = {};
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Transition.pResource = m_buffers[m_boundBackBuffer];
+		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		barrier.Transition.StateBefore = before;
+		barrier.Transition.StateAfter = after;
+		m_cmdList->ResourceBarrier( 1, &barrier );
+	}
+
 	void DXContext::ReleaseBuffers()
 	{
 		for (int32_t i = 0; i < m_bufferCount; ++i)
@@ -241,8 +786,8 @@ namespace Exodus
 		swapChainDesc.Scaling = DXGI_SCALING_STRETCH;
 		swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
 		swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
-		// It is recommended to always allow tearing if tearing support is available.
-		swapChainDesc.Flags = CheckTearingSupport() ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING | DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH : DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
+		// decided here for the swap chain's lifetime, ResizeBuffers() has to pass the same flag
+		swapChainDesc.Flags = GetSwapChainFlags() | (m_maxFrameLatency > 0 ? DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT : 0);
 		DXGI_SWAP_CHAIN_FULLSCREEN_DESC swapChainFullDesc = {};
 		swapChainFullDesc.Windowed = true;
 		ComPointer<IDXGISwapChain1> swapChain1;
@@ -256,6 +801,15 @@ namespace Exodus
 			return false;
 		}
 
+		if (m_maxFrameLatency > 0)
+		{
+			if (FAILED( m_swapChain->SetMaximumFrameLatency( m_maxFrameLatency ) ))
+			{
+				return false;
+			}
+			m_frameLatencyWaitable = m_swapChain->GetFrameLatencyWaitableObject();
+		}
+
 		if (!GetBuffers())
 		{
 			return false;
@@ -264,6 +818,17 @@ namespace Exodus
 		return true;
 	}
 
+	UINT DXContext::GetSwapChainFlags()
+	{
+		// It is recommended to always allow tearing if tearing support is available.
+		UINT flags = CheckTearingSupport() ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING | DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH : DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
+		if (m_frameLatencyWaitable)
+		{
+			flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+		}
+		return flags;
+	}
+
 	bool DXContext::CheckTearingSupport()
 	{
 		BOOL allowTearing = FALSE;
@@ -21,22 +21,115 @@
 #include "Support/WinInclude.h"
 #include "Support/ComPointer.h"
 #include "Windows/Window.h"
+#include "CommandListPool.h"
+#include "DescriptorAllocator.h"
+#include "FrameRing.h"
+#include "ReleaseQueue.h"
+#include "UploadRing.h"
+
+#include <vector>
 
 namespace Exodus
 {
 	class DXContext
 	{
+	public:
+		// sort key of the list between InitCommandList() and ExecuteCommandList()
+		static constexpr uint64_t frameListSortKey = 1ull << 63;
+		// list recorded off the main thread, see AcquireCommandList()
+		struct RecordingList
+		{
+			ID3D12GraphicsCommandList10* list = nullptr;
+			uint32_t index = CommandListPool::invalidIndex;
+		};
+		// slot in one of the shader-visible heaps
+		struct Descriptor
+		{
+			UINT index = DescriptorAllocator::invalidIndex;
+			D3D12_CPU_DESCRIPTOR_HANDLE cpu = {};
+			D3D12_GPU_DESCRIPTOR_HANDLE gpu = {};
+
+			bool IsValid() const noexcept
+			{
+				return index != DescriptorAllocator::invalidIndex;
+			}
+		};
+	private:
+		struct DescriptorHeap
+		{
+			ComPointer<ID3D12DescriptorHeap> heap;
+			DescriptorAllocator allocator;
+			UINT increment = 0;
+			D3D12_CPU_DESCRIPTOR_HANDLE cpuStart = {};
+			D3D12_GPU_DESCRIPTOR_HANDLE gpuStart = {};
+		};
 	public:
 		bool Init( Window* wnd );
 		void Shutdown();
 
 		void SignalAndWait();
+		// the current back buffer is cleared and bound as the render target until ExecuteCommandList()
 		ID3D12GraphicsCommandList10* InitCommandList();
 		void ExecuteCommandList();
 		void Present();
 		void ToggleVSync();
 		void Flush();
-		bool Resize( Window* wnd );
+		bool Resize( UINT width, UINT height );
+		// Low-latency mode: the swap chain gets a frame latency waitable object and
+		// WaitForFrameLatency() blocks until fewer than frames presents are queued. Turning it on
+		// or off only takes effect when the swap chain is created, the count can change any time.
+		void SetMaxFrameLatency( UINT frames );
+		// seconds waited, 0 when low-latency mode is off
+		float WaitForFrameLatency();
+
+		// Uploads are staged in a persistently mapped ring on the upload heap and copied on a
+		// dedicated copy queue. ExecuteCommandList() submits them and has the frame wait for them
+		// on the GPU, the CPU only blocks while the ring is full. Copy queues can't transition,
+		// destinations have to be in the COMMON state.
+		bool UploadBuffer( ID3D12Resource* destination, UINT64 destinationOffset, const void* data, UINT64 size );
+		// every subresource in one go, they have to fit the ring together
+		bool UploadTexture( ID3D12Resource* destination, UINT firstSubresource, UINT subresourceCount, const D3D12_SUBRESOURCE_DATA* subresources );
+		// submits the copies recorded so far, returns the copy fence value they signal
+		UINT64 SubmitUploads();
+
+		// Parallel recording: any thread can take a reset list with the descriptor heaps bound,
+		// record into it and hand it back. ExecuteCommandList() submits the lists handed back
+		// so far together with the frame list in one call, ordered by sortKey, lists keyed
+		// below frameListSortKey go before the frame list. Every list has to be handed back
+		// before ExecuteCommandList(), one still recording misses this frame's submission.
+		// Blocks while every allocator is in flight. list is nullptr when all lists are
+		// recording or the device failed to provide one, check it before recording.
+		RecordingList AcquireCommandList( uint64_t sortKey );
+		// closes the list, recording is empty afterwards
+		void FinishCommandList( RecordingList& recording );
+
+		// ImGui draws into the back buffer on the frame list. BeginImGuiFrame() goes after
+		// InitCommandList() and returns false when the DX12 backend isn't initialized,
+		// RenderImGui() ends the ImGui frame and has to come before ExecuteCommandList().
+		bool BeginImGuiFrame();
+		void RenderImGui();
+
+		// The CBV/SRV/UAV and sampler heaps are shader visible and bound by InitCommandList().
+		// type is D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV or D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+		// Long-lived descriptor, invalid when the heap's persistent region is full.
+		Descriptor AllocateDescriptor( D3D12_DESCRIPTOR_HEAP_TYPE type );
+		// reused once the frames that could still read it have completed
+		void FreeDescriptor( D3D12_DESCRIPTOR_HEAP_TYPE type, UINT index );
+		// count contiguous descriptors for a table used by this frame only
+		Descriptor AllocateFrameDescriptors( D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count );
+		ID3D12DescriptorHeap* GetDescriptorHeap( D3D12_DESCRIPTOR_HEAP_TYPE type );
+
+		// Drops object once the frame being recorded has completed on the GPU, instead of
+		// flushing the queue first. object is empty afterwards.
+		template<typename T>
+		void DeferRelease( ComPointer<T>& object )
+		{
+			if (object)
+			{
+				m_releaseQueue.Retire( object.GetRef(), m_fenceValue + 1u );
+				object.Release();
+			}
+		}
 
 		inline ComPointer<IDXGIFactory7>& GetFactory()
 		{
@@ -53,29 +146,90 @@ namespace Exodus
 			return m_cmdQueue;
 		}
 
+		inline ComPointer<ID3D12CommandQueue>& GetCopyQueue()
+		{
+			return m_copyQueue;
+		}
+
 	private:	
+		void WaitForFenceValue( UINT64 fenceValue );
+		void WaitForFenceValue( ID3D12Fence1* fence, UINT64 fenceValue );
+		bool CreateUploadQueue();
+		// offset into m_uploadBuffer, waits on the copy queue while the ring is full
+		UINT64 AllocateUpload( UINT64 size, UINT64 alignment );
+		ID3D12GraphicsCommandList10* GetCopyList();
+		bool CreateDescriptorHeap( DescriptorHeap& heap, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT persistentCount, UINT transientCount );
+		DescriptorHeap& GetHeap( D3D12_DESCRIPTOR_HEAP_TYPE type );
+		Descriptor GetDescriptor( const DescriptorHeap& heap, UINT index ) const;
+		// also creates the render target views
 		bool GetBuffers();
 		void ReleaseBuffers();
+		void TransitionBackBuffer( D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after );
 		bool CreateSwapChain( Window* wnd );
+		UINT GetSwapChainFlags();
 		bool CheckTearingSupport();
 		ComPointer<IDXGIAdapter4> GetAdapter( bool useWarp );
 		ComPointer<ID3D12Device14> CreateDevice( ComPointer<IDXGIAdapter4> adapter );
 	private:
 		static constexpr int32_t m_bufferCount = 2;
+		static constexpr int32_t m_framesInFlight = m_bufferCount;
 
 		ComPointer<IDXGIFactory7> m_factory;
 		ComPointer<ID3D12Device14> m_device;
 		ComPointer<ID3D12CommandQueue> m_cmdQueue;
 
-		ComPointer<ID3D12CommandAllocator> m_cmdAllocator;
+		ComPointer<ID3D12CommandAllocator> m_cmdAllocators[m_framesInFlight];
 		ComPointer<ID3D12GraphicsCommandList10> m_cmdList;
 
 		ComPointer<IDXGISwapChain4> m_swapChain;
 		ComPointer<ID3D12Resource2> m_buffers[m_bufferCount];
+		ComPointer<ID3D12DescriptorHeap> m_rtvHeap;
+		UINT m_rtvIncrement = 0;
+		// back buffer in the render target state on the frame list, invalid when none is
+		static constexpr UINT m_noBackBuffer = UINT( -1 );
+		UINT m_boundBackBuffer = m_noBackBuffer;
+		// 0 when low-latency mode is off
+		UINT m_maxFrameLatency = 0;
+		HANDLE m_frameLatencyWaitable = nullptr;
 
 		ComPointer<ID3D12Fence1> m_fence;		
 		HANDLE m_fenceEvent = nullptr;
 		UINT64 m_fenceValue = 0;
+		FrameRing m_frameRing{ m_framesInFlight };
+		ReleaseQueue m_releaseQueue;
+
+		static constexpr UINT64 m_uploadRingSize = 64ull * 1024ull * 1024ull;
+		ComPointer<ID3D12CommandQueue> m_copyQueue;
+		ComPointer<ID3D12CommandAllocator> m_copyAllocators[m_framesInFlight];
+		ComPointer<ID3D12GraphicsCommandList10> m_copyList;
+		ComPointer<ID3D12Fence1> m_copyFence;
+		UINT64 m_copyFenceValue = 0;
+		// last copy fence value the direct queue was told to wait for
+		UINT64 m_copyWaitValue = 0;
+		FrameRing m_copyRing{ m_framesInFlight };
+		bool m_copyListOpen = false;
+		ComPointer<ID3D12Resource2> m_uploadBuffer;
+		std::byte* m_uploadData = nullptr;
+		UploadRing m_uploadRing;
+
+		// lists handed out at once, each submission keeps its allocator busy for a few frames
+		static constexpr uint32_t m_maxRecordingLists = 64;
+		static constexpr uint32_t m_maxRecordingAllocators = m_maxRecordingLists * (m_framesInFlight + 1);
+		// fixed arrays, so threads can create the objects for their own index without locking
+		ComPointer<ID3D12CommandAllocator> m_recordingAllocators[m_maxRecordingAllocators];
+		ComPointer<ID3D12GraphicsCommandList10> m_recordingLists[m_maxRecordingLists];
+		CommandListPool m_listPool{ m_maxRecordingLists, m_maxRecordingAllocators };
+		std::vector<CommandListPool::Submission> m_submissions;
+		std::vector<ID3D12CommandList*> m_executeLists;
+
+		// tier 1 hardware allows 1,000,000 resource and 2048 sampler descriptors
+		static constexpr UINT m_resourceDescriptors = 65536;
+		static constexpr UINT m_frameResourceDescriptors = 65536;
+		static constexpr UINT m_samplerDescriptors = 1024;
+		static constexpr UINT m_frameSamplerDescriptors = 1024;
+		DescriptorHeap m_resourceHeap;
+		DescriptorHeap m_samplerHeap;
+		bool m_imguiInit = false;
 
 		
 
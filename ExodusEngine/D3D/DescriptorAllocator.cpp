@@ -0,0 +1,99 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "DescriptorAllocator.h"
+
+namespace Exodus
+{
+	DescriptorAllocator::DescriptorAllocator( uint32_t persistentCount, uint32_t transientCount )
+	{
+		Reset( persistentCount, transientCount );
+	}
+
+	void DescriptorAllocator::Reset( uint32_t persistentCount, uint32_t transientCount )
+	{
+		m_persistentCount = persistentCount;
+		m_persistentTop = 0u;
+		m_freeList.clear();
+		m_pendingFree.clear();
+		m_retired.clear();
+		m_transient.Reset( transientCount );
+	}
+
+	uint32_t DescriptorAllocator::AllocatePersistent() noexcept
+	{
+		if (!m_freeList.empty())
+		{
+			const uint32_t index = m_freeList.back();
+			m_freeList.pop_back();
+			return index;
+		}
+		return m_persistentTop < m_persistentCount ? m_persistentTop++ : invalidIndex;
+	}
+
+	void DescriptorAllocator::FreePersistent( uint32_t index )
+	{
+		if (index < m_persistentTop)
+		{
+			m_pendingFree.push_back( index );
+		}
+	}
+
+	uint32_t DescriptorAllocator::AllocateTransient( uint32_t count ) noexcept
+	{
+		const uint64_t offset = m_transient.Allocate( count, 1u );
+		return offset == UploadRing::invalidOffset ? invalidIndex : m_persistentCount + static_cast<uint32_t>(offset);
+	}
+
+	void DescriptorAllocator::MarkSubmitted( uint64_t fenceValue )
+	{
+		m_transient.MarkSubmitted( fenceValue );
+		for (const uint32_t index : m_pendingFree)
+		{
+			m_retired.push_back( { fenceValue, index } );
+		}
+		m_pendingFree.clear();
+	}
+
+	void DescriptorAllocator::Reclaim( uint64_t completedValue )
+	{
+		m_transient.Reclaim( completedValue );
+		while (!m_retired.empty() && m_retired.front().fenceValue <= completedValue)
+		{
+			m_freeList.push_back( m_retired.front().index );
+			m_retired.pop_front();
+		}
+	}
+
+	uint64_t DescriptorAllocator::GetOldestFenceValue() const noexcept
+	{
+		return m_transient.GetOldestFenceValue();
+	}
+
+	DescriptorAllocator::Stats DescriptorAllocator::GetStats() const noexcept
+	{
+		Stats stats;
+		stats.persistentUsed = m_persistentTop - static_cast<uint32_t>(m_freeList.size());
+		stats.persistentCapacity = m_persistentCount;
+		stats.transientUsed = static_cast<uint32_t>(m_transient.GetUsed());
+		stats.transientCapacity = static_cast<uint32_t>(m_transient.GetCapacity());
+		return stats;
+	}
+}
@@ -0,0 +1,76 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "UploadRing.h"
+
+namespace Exodus
+{
+	// Index bookkeeping for one shader-visible descriptor heap, split in two regions:
+	//   [0, persistent)                        single descriptors for long-lived resources
+	//   [persistent, persistent + transient)   contiguous ranges used by one frame
+	// Persistent indices come from a free list, transient ranges are carved linearly and wrap
+	// like UploadRing. Both come back by fence value once no submission can read them.
+	// Every call is O(1) apart from Reclaim(), which is linear in what it returns.
+	class DescriptorAllocator
+	{
+	public:
+		static constexpr uint32_t invalidIndex = ~0u;
+		struct Stats
+		{
+			uint32_t persistentUsed = 0u;
+			uint32_t persistentCapacity = 0u;
+			uint32_t transientUsed = 0u;
+			uint32_t transientCapacity = 0u;
+		};
+	private:
+		struct Retired
+		{
+			uint64_t fenceValue;
+			uint32_t index;
+		};
+	public:
+		explicit DescriptorAllocator( uint32_t persistentCount = 0u, uint32_t transientCount = 0u );
+		// drops everything, only when the GPU no longer reads the heap
+		void Reset( uint32_t persistentCount, uint32_t transientCount );
+		uint32_t AllocatePersistent() noexcept;
+		// handed out again once the next submission completed
+		void FreePersistent( uint32_t index );
+		// first of count contiguous indices, valid until the current submission completed
+		uint32_t AllocateTransient( uint32_t count ) noexcept;
+		// tags the transient ranges and persistent frees since the last call
+		void MarkSubmitted( uint64_t fenceValue );
+		void Reclaim( uint64_t completedValue );
+		// fence value of the oldest transient range still live, 0 when there is none
+		uint64_t GetOldestFenceValue() const noexcept;
+		Stats GetStats() const noexcept;
+	private:
+		uint32_t m_persistentCount = 0u;
+		// indices at and above this were never handed out
+		uint32_t m_persistentTop = 0u;
+		std::vector<uint32_t> m_freeList;
+		// freed since the last MarkSubmitted()
+		std::vector<uint32_t> m_pendingFree;
+		std::deque<Retired> m_retired;
+		UploadRing m_transient;
+	};
+}
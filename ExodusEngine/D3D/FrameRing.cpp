@@ -0,0 +1,76 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "FrameRing.h"
+
+#include <algorithm>
+
+namespace Exodus
+{
+	FrameRing::FrameRing( uint32_t frameCount ) noexcept
+		:
+		m_slotFenceValues( frameCount > 0u ? frameCount : 1u, 0u )
+	{
+	}
+
+	void FrameRing::Reset() noexcept
+	{
+		std::fill( m_slotFenceValues.begin(), m_slotFenceValues.end(), 0u );
+		m_currentSlot = 0u;
+		m_lastSubmittedValue = 0u;
+	}
+
+	uint32_t FrameRing::GetFrameCount() const noexcept
+	{
+		return static_cast<uint32_t>(m_slotFenceValues.size());
+	}
+
+	uint32_t FrameRing::GetCurrentSlot() const noexcept
+	{
+		return m_currentSlot;
+	}
+
+	uint64_t FrameRing::GetWaitValue() const noexcept
+	{
+		return m_slotFenceValues[m_currentSlot];
+	}
+
+	bool FrameRing::NeedsWait( uint64_t completedValue ) const noexcept
+	{
+		return completedValue < m_slotFenceValues[m_currentSlot];
+	}
+
+	void FrameRing::MarkSubmitted( uint64_t fenceValue ) noexcept
+	{
+		m_slotFenceValues[m_currentSlot] = fenceValue;
+		m_lastSubmittedValue = fenceValue;
+	}
+
+	uint64_t FrameRing::GetLastSubmittedValue() const noexcept
+	{
+		return m_lastSubmittedValue;
+	}
+
+	uint32_t FrameRing::Advance() noexcept
+	{
+		m_currentSlot = (m_currentSlot + 1u) % GetFrameCount();
+		return m_currentSlot;
+	}
+}
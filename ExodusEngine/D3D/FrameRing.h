@@ -0,0 +1,47 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Exodus
+{
+	// Bookkeeping for N frames in flight. Each slot remembers the fence value its last
+	// submission signalled, so the CPU only has to wait for the slot it is about to reuse.
+	// Holds no graphics objects, the owner does the actual signal/wait on its queue.
+	class FrameRing
+	{
+	public:
+		explicit FrameRing( uint32_t frameCount ) noexcept;
+		void Reset() noexcept;
+		uint32_t GetFrameCount() const noexcept;
+		uint32_t GetCurrentSlot() const noexcept;
+		// fence value the current slot has to reach before its resources may be reused (0 if never submitted)
+		uint64_t GetWaitValue() const noexcept;
+		bool NeedsWait( uint64_t completedValue ) const noexcept;
+		void MarkSubmitted( uint64_t fenceValue ) noexcept;
+		uint64_t GetLastSubmittedValue() const noexcept;
+		uint32_t Advance() noexcept;
+	private:
+		std::vector<uint64_t> m_slotFenceValues;
+		uint32_t m_currentSlot = 0u;
+		uint64_t m_lastSubmittedValue = 0u;
+	};
+}
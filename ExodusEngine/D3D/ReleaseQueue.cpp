@@ -0,0 +1,67 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ReleaseQueue.h"
+
+namespace Exodus
+{
+	ReleaseQueue::~ReleaseQueue()
+	{
+		ReleaseAll();
+	}
+
+	size_t ReleaseQueue::Release( uint64_t completedValue )
+	{
+		// objects dropped outside the frame carry a later fence value than the ones retired
+		// after them, a pending entry must not hold up the completed ones behind it
+		size_t kept = 0u;
+		for (size_t i = 0u; i < m_entries.size(); ++i)
+		{
+			const Entry entry = m_entries[i];
+			if (entry.fenceValue <= completedValue)
+			{
+				entry.release( entry.object );
+			}
+			else
+			{
+				m_entries[kept++] = entry;
+			}
+		}
+		const size_t released = m_entries.size() - kept;
+		m_entries.resize( kept );
+		return released;
+	}
+
+	size_t ReleaseQueue::ReleaseAll()
+	{
+		const size_t released = m_entries.size();
+		for (const Entry& entry : m_entries)
+		{
+			entry.release( entry.object );
+		}
+		m_entries.clear();
+		return released;
+	}
+
+	size_t ReleaseQueue::GetPendingCount() const noexcept
+	{
+		return m_entries.size();
+	}
+}
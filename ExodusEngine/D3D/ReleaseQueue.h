@@ -0,0 +1,65 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Exodus
+{
+	// Holds on to GPU objects until the submission that last used them has completed, then
+	// releases them in bulk, so dropping a resource never needs a flush. Fence values don't
+	// have to be retired in order, every entry goes as soon as its own value has been reached.
+	// One queue per fence timeline.
+	// Works on anything reference counted through Release(), so it has no D3D dependency.
+	class ReleaseQueue
+	{
+	private:
+		struct Entry
+		{
+			uint64_t fenceValue;
+			void* object;
+			void (*release)( void* object );
+		};
+	public:
+		ReleaseQueue() = default;
+		// releases what is left, the owner makes sure the GPU is idle by then
+		~ReleaseQueue();
+		ReleaseQueue( const ReleaseQueue& ) = delete;
+		ReleaseQueue& operator=( const ReleaseQueue& ) = delete;
+
+		// takes over one reference to object, dropped once fenceValue has been reached
+		template<typename T>
+		void Retire( T* object, uint64_t fenceValue )
+		{
+			if (!object)
+			{
+				return;
+			}
+			m_entries.push_back( { fenceValue, object, []( void* p ) { static_cast<T*>(p)->Release(); } } );
+		}
+		// releases the objects whose fence value has been reached, returns how many
+		size_t Release( uint64_t completedValue );
+		size_t ReleaseAll();
+		size_t GetPendingCount() const noexcept;
+	private:
+		std::vector<Entry> m_entries;
+	};
+}
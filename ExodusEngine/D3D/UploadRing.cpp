@@ -0,0 +1,107 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "UploadRing.h"
+
+namespace Exodus
+{
+	UploadRing::UploadRing( uint64_t capacity ) noexcept
+		:
+		m_capacity( capacity )
+	{
+	}
+
+	void UploadRing::Reset( uint64_t capacity ) noexcept
+	{
+		m_submissions.clear();
+		m_capacity = capacity;
+		m_head = 0u;
+		m_tail = 0u;
+		m_submitted = 0u;
+	}
+
+	uint64_t UploadRing::Allocate( uint64_t size, uint64_t alignment ) noexcept
+	{
+		if (size == 0u || size > m_capacity)
+		{
+			return invalidOffset;
+		}
+		if (m_head == m_tail)
+		{
+			// empty, start over at the front so a large allocation doesn't have to wrap
+			m_head = 0u;
+			m_tail = 0u;
+			m_submitted = 0u;
+		}
+		const uint64_t position = m_head % m_capacity;
+		uint64_t offset = (position + alignment - 1u) & ~(alignment - 1u);
+		if (offset + size > m_capacity)
+		{
+			// the rest of the buffer is skipped, allocations never straddle the end
+			offset = 0u;
+		}
+		const uint64_t consumed = (offset >= position ? offset - position : m_capacity - position + offset) + size;
+		if (GetUsed() + consumed > m_capacity)
+		{
+			return invalidOffset;
+		}
+		m_head += consumed;
+		return offset;
+	}
+
+	void UploadRing::MarkSubmitted( uint64_t fenceValue )
+	{
+		if (m_head == m_submitted)
+		{
+			return;
+		}
+		m_submissions.push_back( { fenceValue, m_head } );
+		m_submitted = m_head;
+	}
+
+	void UploadRing::Reclaim( uint64_t completedValue ) noexcept
+	{
+		while (!m_submissions.empty() && m_submissions.front().fenceValue <= completedValue)
+		{
+			m_tail = m_submissions.front().end;
+			m_submissions.pop_front();
+		}
+	}
+
+	uint64_t UploadRing::GetOldestFenceValue() const noexcept
+	{
+		return m_submissions.empty() ? 0u : m_submissions.front().fenceValue;
+	}
+
+	bool UploadRing::HasUnsubmitted() const noexcept
+	{
+		return m_head != m_submitted;
+	}
+
+	uint64_t UploadRing::GetCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	uint64_t UploadRing::GetUsed() const noexcept
+	{
+		return m_head - m_tail;
+	}
+}
@@ -0,0 +1,65 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <deque>
+
+namespace Exodus
+{
+	// Sub-allocates a fixed size upload buffer front to back, wrapping at the end. Allocations
+	// made between two MarkSubmitted() calls are retired together once their fence completes,
+	// so reclaiming is a pop from the front. Holds no graphics objects, like FrameRing.
+	class UploadRing
+	{
+	public:
+		static constexpr uint64_t invalidOffset = ~0ull;
+	private:
+		struct Submission
+		{
+			uint64_t fenceValue;
+			// m_head when it was submitted
+			uint64_t end;
+		};
+	public:
+		explicit UploadRing( uint64_t capacity = 0u ) noexcept;
+		// drops everything, only when the GPU no longer reads the buffer
+		void Reset( uint64_t capacity ) noexcept;
+		// offset into the buffer, invalidOffset if it doesn't fit before older uploads retire.
+		// alignment must be a power of two.
+		uint64_t Allocate( uint64_t size, uint64_t alignment ) noexcept;
+		// tags what was allocated since the last call with the fence value of the submission reading it
+		void MarkSubmitted( uint64_t fenceValue );
+		// frees submissions whose fence value has been reached
+		void Reclaim( uint64_t completedValue ) noexcept;
+		// fence value of the oldest live submission, 0 when there is none
+		uint64_t GetOldestFenceValue() const noexcept;
+		bool HasUnsubmitted() const noexcept;
+		uint64_t GetCapacity() const noexcept;
+		// including the padding skipped when an allocation wrapped
+		uint64_t GetUsed() const noexcept;
+	private:
+		std::deque<Submission> m_submissions;
+		uint64_t m_capacity = 0u;
+		// running byte counts, the buffer offset is the count modulo the capacity
+		uint64_t m_head = 0u;
+		uint64_t m_tail = 0u;
+		uint64_t m_submitted = 0u;
+	};
+}
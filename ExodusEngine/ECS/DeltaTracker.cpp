@@ -0,0 +1,183 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "DeltaTracker.h"
+
+#include <iterator>
+
+namespace Exodus
+{
+	DeltaTracker::DeltaTracker( Registry& registry )
+		:
+		m_registry( registry )
+	{
+	}
+
+	DeltaTracker::~DeltaTracker()
+	{
+		m_registry.on_construct<entt::entity>().disconnect( this );
+		m_registry.on_destroy<entt::entity>().disconnect( this );
+		for (const auto& track : m_tracks)
+		{
+			track->Disconnect( m_registry );
+		}
+	}
+
+	void DeltaTracker::ConnectEntities()
+	{
+		m_registry.on_construct<entt::entity>().connect<&DeltaTracker::OnCreate>( *this );
+		m_registry.on_destroy<entt::entity>().connect<&DeltaTracker::OnDestroy>( *this );
+	}
+
+	bool DeltaTracker::IsTracking() const noexcept
+	{
+		return !m_tracks.empty();
+	}
+
+	RegistryDelta DeltaTracker::Commit()
+	{
+		RegistryDelta delta;
+		std::sort( m_created.begin(), m_created.end() );
+		std::sort( m_destroyed.begin(), m_destroyed.end() );
+		// entities that were created and destroyed again within the tick cancel out
+		std::set_difference( m_created.begin(), m_created.end(), m_destroyed.begin(), m_destroyed.end(), std::back_inserter( delta.created ) );
+		std::set_difference( m_destroyed.begin(), m_destroyed.end(), m_created.begin(), m_created.end(), std::back_inserter( delta.destroyed ) );
+		m_created.clear();
+		m_destroyed.clear();
+		for (uint32_t i = 0u; i < m_tracks.size(); ++i)
+		{
+			m_tracks[i]->Commit( m_registry, delta, i );
+		}
+		return delta;
+	}
+
+	void DeltaTracker::Apply( const RegistryDelta& delta )
+	{
+		Apply( delta, true );
+	}
+
+	void DeltaTracker::Revert( const RegistryDelta& delta )
+	{
+		Apply( delta, false );
+	}
+
+	void DeltaTracker::Write( const RegistryDelta& delta, SnapshotOutput& out ) const
+	{
+		out( static_cast<uint32_t>(delta.created.size()) );
+		out.Write( delta.created.data(), delta.created.size() * sizeof( entt::entity ) );
+		out( static_cast<uint32_t>(delta.destroyed.size()) );
+		out.Write( delta.destroyed.data(), delta.destroyed.size() * sizeof( entt::entity ) );
+		out( static_cast<uint32_t>(delta.pools.size()) );
+		for (const auto& pool : delta.pools)
+		{
+			m_tracks[pool->track]->Write( *pool, out );
+		}
+	}
+
+	bool DeltaTracker::Read( SnapshotInput& in, RegistryDelta& delta ) const
+	{
+		delta = RegistryDelta();
+		for (DeltaVector<entt::entity>* target : { &delta.created, &delta.destroyed })
+		{
+			uint32_t count = 0u;
+			in( count );
+			if (in.IsFailed() || count > in.GetRemaining() / sizeof( entt::entity ))
+			{
+				return false;
+			}
+			target->resize( count );
+			in.Read( target->data(), count * sizeof( entt::entity ) );
+		}
+		uint32_t poolCount = 0u;
+		in( poolCount );
+		for (uint32_t p = 0u; p < poolCount && !in.IsFailed(); ++p)
+		{
+			uint32_t hash = 0u;
+			in( hash );
+			const auto track = std::find_if( m_tracks.begin(), m_tracks.end(), [hash]( const auto& t ) { return t->GetHash() == hash; } );
+			if (track == m_tracks.end())
+			{
+				return false;
+			}
+			auto pool = (*track)->Read( in, static_cast<uint32_t>(track - m_tracks.begin()) );
+			if (!pool)
+			{
+				return false;
+			}
+			delta.pools.push_back( std::move( pool ) );
+		}
+		return !in.IsFailed();
+	}
+
+	void DeltaTracker::OnCreate( Registry&, entt::entity entity )
+	{
+		if (!m_suspended)
+		{
+			m_created.push_back( entity );
+		}
+	}
+
+	void DeltaTracker::OnDestroy( Registry&, entt::entity entity )
+	{
+		if (!m_suspended)
+		{
+			m_destroyed.push_back( entity );
+		}
+	}
+
+	void DeltaTracker::ApplyEntities( const DeltaVector<entt::entity>& destroy, const DeltaVector<entt::entity>& create )
+	{
+		for (const entt::entity entity : destroy)
+		{
+			if (m_registry.valid( entity ))
+			{
+				m_registry.destroy( entity );
+			}
+		}
+		for (const entt::entity entity : create)
+		{
+			// the slot is free again, so the hint brings back the exact identifier
+			static_cast<void>(m_registry.create( entity ));
+		}
+	}
+
+	void DeltaTracker::Apply( const RegistryDelta& delta, bool forward )
+	{
+		m_suspended = true;
+		// removals first and assignments last, an index freed in the tick may have been reused
+		for (const auto& pool : delta.pools)
+		{
+			m_tracks[pool->track]->ApplyRemovals( m_registry, *pool, forward );
+		}
+		if (forward)
+		{
+			ApplyEntities( delta.destroyed, delta.created );
+		}
+		else
+		{
+			ApplyEntities( delta.created, delta.destroyed );
+		}
+		for (const auto& pool : delta.pools)
+		{
+			m_tracks[pool->track]->ApplyAssignments( m_registry, *pool, forward );
+		}
+		m_suspended = false;
+	}
+}
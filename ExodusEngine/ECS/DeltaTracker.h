@@ -0,0 +1,443 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "Registry.h"
+#include "Snapshot.h"
+#include "Memory/TrackedAllocator.h"
+
+namespace Exodus
+{
+	template<typename T>
+	using DeltaVector = std::vector<T, TrackedAllocator<T, MemoryTag::ECS>>;
+
+	// Changes to one tracked component type, one record per entity. A record keeps the value
+	// before and/or after the tick, a missing one means the component was absent.
+	struct PoolDelta
+	{
+		enum Flags : uint8_t
+		{
+			HasBefore = 1u,
+			HasAfter = 2u,
+		};
+		virtual ~PoolDelta() = default;
+		uint32_t track = 0u;
+		DeltaVector<entt::entity> entities;
+		DeltaVector<uint8_t> flags;
+	};
+
+	// Everything that changed in the tracked part of a registry between two commits.
+	struct RegistryDelta
+	{
+		bool Empty() const noexcept
+		{
+			return created.empty() && destroyed.empty() && pools.empty();
+		}
+		DeltaVector<entt::entity> created;
+		DeltaVector<entt::entity> destroyed;
+		std::vector<std::unique_ptr<PoolDelta>> pools;
+	};
+
+	// Records per-tick deltas of a registry: created and destroyed entities plus the changed
+	// components of the tracked types, keeping before and after values so a delta can be applied
+	// forward or reverted. Changes are picked up from the storage signals, so writes have to go
+	// through emplace/patch/replace/remove, or be announced with Touch<T>() when a system writes
+	// through a View. Only tracked components are restored when a destroyed entity is revived.
+	// Nothing is recorded before the first Track<T>(), after it the changes pile up until the
+	// next Commit(), so commit every tick even when the delta isn't kept.
+	//   tracker.Track<Position>();
+	//   RegistryDelta delta = tracker.Commit();
+	//   tracker.Revert( delta );
+	class DeltaTracker
+	{
+	private:
+		class PoolTrack
+		{
+		public:
+			virtual ~PoolTrack() = default;
+			virtual uint32_t GetHash() const noexcept = 0;
+			virtual void Disconnect( Registry& registry ) = 0;
+			virtual void Commit( Registry& registry, RegistryDelta& delta, uint32_t index ) = 0;
+			// removals run before entities are destroyed/created, assignments after
+			virtual void ApplyRemovals( Registry& registry, const PoolDelta& pool, bool forward ) = 0;
+			virtual void ApplyAssignments( Registry& registry, const PoolDelta& pool, bool forward ) = 0;
+			virtual void Write( const PoolDelta& pool, SnapshotOutput& out ) const = 0;
+			virtual std::unique_ptr<PoolDelta> Read( SnapshotInput& in, uint32_t index ) const = 0;
+		};
+		template<typename T>
+		class ComponentTrack;
+	public:
+		explicit DeltaTracker( Registry& registry );
+		~DeltaTracker();
+		DeltaTracker( const DeltaTracker& ) = delete;
+		DeltaTracker& operator=( const DeltaTracker& ) = delete;
+
+		// starts from the current contents of the pool, tracking a type twice is a no-op
+		template<typename T>
+		void Track();
+		// marks a component written without a signal, safe from a system with write access to T
+		template<typename T>
+		void Touch( entt::entity entity );
+		bool IsTracking() const noexcept;
+		// the changes since the previous commit, cost scales with the number of changes
+		RegistryDelta Commit();
+		// the registry has to be in the state the delta starts from (Apply) or ends at (Revert),
+		// entities keep their identifiers, uncommitted changes are not touched
+		void Apply( const RegistryDelta& delta );
+		void Revert( const RegistryDelta& delta );
+		// deltas can only be read back by a tracker with the same types
+		void Write( const RegistryDelta& delta, SnapshotOutput& out ) const;
+		bool Read( SnapshotInput& in, RegistryDelta& delta ) const;
+	private:
+		void ConnectEntities();
+		void OnCreate( Registry& registry, entt::entity entity );
+		void OnDestroy( Registry& registry, entt::entity entity );
+		void ApplyEntities( const DeltaVector<entt::entity>& destroy, const DeltaVector<entt::entity>& create );
+		void Apply( const RegistryDelta& delta, bool forward );
+	private:
+		Registry& m_registry;
+		std::vector<std::unique_ptr<PoolTrack>> m_tracks;
+		DeltaVector<entt::entity> m_created;
+		DeltaVector<entt::entity> m_destroyed;
+		// set while a delta is applied so the changes it makes aren't recorded again
+		bool m_suspended = false;
+	};
+
+	template<typename T>
+	class DeltaTracker::ComponentTrack : public PoolTrack
+	{
+	private:
+		static constexpr bool hasValue = entt::component_traits<T>::page_size != 0u;
+		using Shadow = entt::basic_storage<T, entt::entity, PoolAllocator<T, MemoryTag::ECS>>;
+		struct Values : PoolDelta
+		{
+			DeltaVector<T> before;
+			DeltaVector<T> after;
+		};
+	public:
+		ComponentTrack( Registry& registry, const bool& suspended )
+			:
+			m_suspended( suspended )
+		{
+			auto& storage = registry.storage<T>();
+			m_shadow.reserve( storage.size() );
+			if constexpr (hasValue)
+			{
+				for (const auto [entity, value] : storage.each())
+				{
+					m_shadow.emplace( entity, value );
+				}
+			}
+			else
+			{
+				for (const auto [entity] : storage.each())
+				{
+					m_shadow.emplace( entity );
+				}
+			}
+			registry.on_construct<T>().template connect<&ComponentTrack::Touch>( *this );
+			registry.on_update<T>().template connect<&ComponentTrack::Touch>( *this );
+			registry.on_destroy<T>().template connect<&ComponentTrack::Touch>( *this );
+		}
+		uint32_t GetHash() const noexcept override
+		{
+			return static_cast<uint32_t>(entt::type_hash<T>::value());
+		}
+		void Disconnect( Registry& registry ) override
+		{
+			registry.on_construct<T>().disconnect( this );
+			registry.on_update<T>().disconnect( this );
+			registry.on_destroy<T>().disconnect( this );
+		}
+		void Touch( Registry&, entt::entity entity )
+		{
+			if (!m_suspended)
+			{
+				m_dirty.push_back( entity );
+			}
+		}
+		void Commit( Registry& registry, RegistryDelta& delta, uint32_t index ) override;
+		void ApplyRemovals( Registry& registry, const PoolDelta& pool, bool forward ) override;
+		void ApplyAssignments( Registry& registry, const PoolDelta& pool, bool forward ) override;
+		void Write( const PoolDelta& pool, SnapshotOutput& out ) const override;
+		std::unique_ptr<PoolDelta> Read( SnapshotInput& in, uint32_t index ) const override;
+	private:
+		// the committed state, diffed against the registry for every dirty entity
+		Shadow m_shadow;
+		DeltaVector<entt::entity> m_dirty;
+		const bool& m_suspended;
+	};
+
+	template<typename T>
+	void DeltaTracker::Track()
+	{
+		const uint32_t hash = static_cast<uint32_t>(entt::type_hash<T>::value());
+		if (std::none_of( m_tracks.begin(), m_tracks.end(), [hash]( const auto& track ) { return track->GetHash() == hash; } ))
+		{
+			if (m_tracks.empty())
+			{
+				ConnectEntities();
+			}
+			m_tracks.push_back( std::make_unique<ComponentTrack<T>>( m_registry, m_suspended ) );
+		}
+	}
+
+	template<typename T>
+	void DeltaTracker::Touch( entt::entity entity )
+	{
+		const uint32_t hash = static_cast<uint32_t>(entt::type_hash<T>::value());
+		for (const auto& track : m_tracks)
+		{
+			if (track->GetHash() == hash)
+			{
+				static_cast<ComponentTrack<T>&>(*track).Touch( m_registry, entity );
+				return;
+			}
+		}
+	}
+
+	template<typename T>
+	void DeltaTracker::ComponentTrack<T>::Commit( Registry& registry, RegistryDelta& delta, uint32_t index )
+	{
+		if (m_dirty.empty())
+		{
+			return;
+		}
+		std::sort( m_dirty.begin(), m_dirty.end() );
+		m_dirty.erase( std::unique( m_dirty.begin(), m_dirty.end() ), m_dirty.end() );
+		const auto& storage = registry.storage<T>();
+		auto pool = std::make_unique<Values>();
+		pool->track = index;
+		for (const entt::entity entity : m_dirty)
+		{
+			const bool had = m_shadow.contains( entity );
+			const bool has = storage.contains( entity );
+			if (!had && !has)
+			{
+				continue;
+			}
+			if constexpr (hasValue)
+			{
+				if constexpr (std::equality_comparable<T>)
+				{
+					// patched without changing the value
+					if (had && has && m_shadow.get( entity ) == storage.get( entity ))
+					{
+						continue;
+					}
+				}
+				if (had)
+				{
+					pool->before.push_back( m_shadow.get( entity ) );
+				}
+				if (has)
+				{
+					pool->after.push_back( storage.get( entity ) );
+				}
+			}
+			else if (had && has)
+			{
+				continue;
+			}
+			pool->entities.push_back( entity );
+			pool->flags.push_back( static_cast<uint8_t>((had ? uint32_t( PoolDelta::HasBefore ) : 0u) | (has ? uint32_t( PoolDelta::HasAfter ) : 0u)) );
+		}
+		m_dirty.clear();
+		if (pool->entities.empty())
+		{
+			return;
+		}
+		// an index can be freed and reused within one tick, so the shadow drops entries first
+		for (size_t i = 0u; i < pool->entities.size(); ++i)
+		{
+			if (!(pool->flags[i] & PoolDelta::HasAfter))
+			{
+				m_shadow.erase( pool->entities[i] );
+			}
+		}
+		size_t after = 0u;
+		for (size_t i = 0u; i < pool->entities.size(); ++i)
+		{
+			if (pool->flags[i] & PoolDelta::HasAfter)
+			{
+				const entt::entity entity = pool->entities[i];
+				if constexpr (hasValue)
+				{
+					if (pool->flags[i] & PoolDelta::HasBefore)
+					{
+						m_shadow.get( entity ) = pool->after[after];
+					}
+					else
+					{
+						m_shadow.emplace( entity, pool->after[after] );
+					}
+					++after;
+				}
+				else
+				{
+					m_shadow.emplace( entity );
+				}
+			}
+		}
+		delta.pools.push_back( std::move( pool ) );
+	}
+
+	template<typename T>
+	void DeltaTracker::ComponentTrack<T>::ApplyRemovals( Registry& registry, const PoolDelta& pool, bool forward )
+	{
+		const uint8_t keep = forward ? PoolDelta::HasAfter : PoolDelta::HasBefore;
+		for (size_t i = 0u; i < pool.entities.size(); ++i)
+		{
+			if (!(pool.flags[i] & keep))
+			{
+				const entt::entity entity = pool.entities[i];
+				registry.remove<T>( entity );
+				m_shadow.remove( entity );
+			}
+		}
+	}
+
+	template<typename T>
+	void DeltaTracker::ComponentTrack<T>::ApplyAssignments( Registry& registry, const PoolDelta& pool, bool forward )
+	{
+		const uint8_t keep = forward ? PoolDelta::HasAfter : PoolDelta::HasBefore;
+		const auto& values = static_cast<const Values&>(pool);
+		const DeltaVector<T>& source = forward ? values.after : values.before;
+		size_t next = 0u;
+		for (size_t i = 0u; i < pool.entities.size(); ++i)
+		{
+			if (!(pool.flags[i] & keep))
+			{
+				continue;
+			}
+			const entt::entity entity = pool.entities[i];
+			if constexpr (hasValue)
+			{
+				const T& value = source[next++];
+				registry.emplace_or_replace<T>( entity, value );
+				if (m_shadow.contains( entity ))
+				{
+					m_shadow.get( entity ) = value;
+				}
+				else
+				{
+					m_shadow.emplace( entity, value );
+				}
+			}
+			else
+			{
+				registry.emplace_or_replace<T>( entity );
+				if (!m_shadow.contains( entity ))
+				{
+					m_shadow.emplace( entity );
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void DeltaTracker::ComponentTrack<T>::Write( const PoolDelta& pool, SnapshotOutput& out ) const
+	{
+		const auto& values = static_cast<const Values&>(pool);
+		out( GetHash() );
+		out( static_cast<uint32_t>(pool.entities.size()) );
+		out.Write( pool.entities.data(), pool.entities.size() * sizeof( entt::entity ) );
+		out.Write( pool.flags.data(), pool.flags.size() );
+		if constexpr (hasValue)
+		{
+			out( static_cast<uint32_t>(values.before.size()) );
+			out( static_cast<uint32_t>(values.after.size()) );
+			for (const DeltaVector<T>* source : { &values.before, &values.after })
+			{
+				if constexpr (std::is_trivially_copyable_v<T>)
+				{
+					out.Write( source->data(), source->size() * sizeof( T ) );
+				}
+				else
+				{
+					for (const T& value : *source)
+					{
+						out( value );
+					}
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	std::unique_ptr<PoolDelta> DeltaTracker::ComponentTrack<T>::Read( SnapshotInput& in, uint32_t index ) const
+	{
+		auto pool = std::make_unique<Values>();
+		pool->track = index;
+		uint32_t count = 0u;
+		in( count );
+		// a corrupt count must not turn into a huge allocation
+		if (in.IsFailed() || count > in.GetRemaining() / (sizeof( entt::entity ) + 1u))
+		{
+			return nullptr;
+		}
+		pool->entities.resize( count );
+		pool->flags.resize( count );
+		in.Read( pool->entities.data(), count * sizeof( entt::entity ) );
+		in.Read( pool->flags.data(), count );
+		// Apply() walks the values by these flags, the sizes below have to match them exactly
+		uint32_t flaggedBefore = 0u;
+		uint32_t flaggedAfter = 0u;
+		for (const uint8_t flags : pool->flags)
+		{
+			if (flags & ~uint32_t( PoolDelta::HasBefore | PoolDelta::HasAfter ))
+			{
+				return nullptr;
+			}
+			flaggedBefore += (flags & PoolDelta::HasBefore) ? 1u : 0u;
+			flaggedAfter += (flags & PoolDelta::HasAfter) ? 1u : 0u;
+		}
+		if constexpr (hasValue)
+		{
+			uint32_t before = 0u;
+			uint32_t after = 0u;
+			in( before );
+			in( after );
+			if (before != flaggedBefore || after != flaggedAfter)
+			{
+				return nullptr;
+			}
+			pool->before.resize( before );
+			pool->after.resize( after );
+			for (DeltaVector<T>* target : { &pool->before, &pool->after })
+			{
+				for (T& value : *target)
+				{
+					in( value );
+				}
+			}
+		}
+		if (in.IsFailed())
+		{
+			return nullptr;
+		}
+		return pool;
+	}
+}
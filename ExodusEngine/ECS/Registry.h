@@ -0,0 +1,42 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include "Memory/PagePool.h"
+
+#include "entt.hpp" // https://github.com/skypjack/entt
+
+namespace Exodus
+{
+	// The engine's registry. Its allocator reaches every component pool: sparse and component
+	// pages come from the PagePool, all ECS memory is counted under MemoryTag::ECS.
+	using RegistryAllocator = PoolAllocator<entt::entity, MemoryTag::ECS>;
+	using Registry = entt::basic_registry<entt::entity, RegistryAllocator>;
+
+	template<typename Type>
+	struct RegistryStorage
+	{
+		using type = typename Registry::template storage_for_type<Type>;
+	};
+
+	// entt::view for the engine registry, entt::view itself names std::allocator storages
+	//   void Move( View<entt::get_t<Position, const Velocity>> view );
+	template<typename Get, typename Exclude = entt::exclude_t<>>
+	using View = entt::basic_view<entt::type_list_transform_t<Get, RegistryStorage>, entt::type_list_transform_t<Exclude, RegistryStorage>>;
+}
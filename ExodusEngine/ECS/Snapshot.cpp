@@ -0,0 +1,173 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Snapshot.h"
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr char snapshotMagic[4] = { 'E', 'X', 'S', 'N' };
+		constexpr uint32_t snapshotVersion = 1u;
+		constexpr size_t outputBufferSize = 256u * 1024u;
+	}
+
+	SnapshotOutput::SnapshotOutput( std::ostream& stream )
+		:
+		m_stream( stream ),
+		m_buffer( outputBufferSize )
+	{
+	}
+
+	SnapshotOutput::~SnapshotOutput()
+	{
+		Flush();
+	}
+
+	void SnapshotOutput::Write( const void* data, size_t bytes )
+	{
+		if (bytes == 0u)
+		{
+			return;
+		}
+		if (bytes >= outputBufferSize / 2u)
+		{
+			// large blocks skip the buffer
+			Flush();
+			m_stream.write( static_cast<const char*>(data), static_cast<std::streamsize>(bytes) );
+		}
+		else
+		{
+			if (m_used + bytes > m_buffer.size())
+			{
+				Flush();
+			}
+			std::memcpy( m_buffer.data() + m_used, data, bytes );
+			m_used += bytes;
+		}
+		m_offset += bytes;
+	}
+
+	void SnapshotOutput::WriteString( const std::string& text )
+	{
+		const uint32_t length = static_cast<uint32_t>(text.size());
+		Write( &length, sizeof( length ) );
+		Write( text.data(), text.size() );
+	}
+
+	void SnapshotOutput::Align( size_t alignment )
+	{
+		static constexpr std::byte zeros[256] = {};
+		const size_t padding = static_cast<size_t>((alignment - m_offset % alignment) % alignment);
+		Write( zeros, padding );
+	}
+
+	void SnapshotOutput::Flush()
+	{
+		if (m_used > 0u)
+		{
+			m_stream.write( reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_used) );
+			m_used = 0u;
+		}
+	}
+
+	bool SnapshotOutput::IsGood() const noexcept
+	{
+		return static_cast<bool>(m_stream);
+	}
+
+	SnapshotInput::SnapshotInput( const std::byte* data, size_t size ) noexcept
+		:
+		m_data( data ),
+		m_size( size )
+	{
+	}
+
+	void SnapshotInput::Read( void* data, size_t bytes ) noexcept
+	{
+		if (bytes == 0u)
+		{
+			return;
+		}
+		if (const std::byte* source = Take( bytes ))
+		{
+			std::memcpy( data, source, bytes );
+		}
+		else
+		{
+			std::memset( data, 0, bytes );
+		}
+	}
+
+	std::string SnapshotInput::ReadString()
+	{
+		uint32_t length = 0u;
+		Read( &length, sizeof( length ) );
+		const std::byte* text = Take( length );
+		return text ? std::string( reinterpret_cast<const char*>(text), length ) : std::string();
+	}
+
+	const std::byte* SnapshotInput::Take( size_t bytes ) noexcept
+	{
+		if (m_failed || m_size - m_cursor < bytes)
+		{
+			m_failed = true;
+			return nullptr;
+		}
+		const std::byte* data = m_data + m_cursor;
+		m_cursor += bytes;
+		return data;
+	}
+
+	void SnapshotInput::Align( size_t alignment ) noexcept
+	{
+		Take( (alignment - m_cursor % alignment) % alignment );
+	}
+
+	size_t SnapshotInput::GetRemaining() const noexcept
+	{
+		return m_size - m_cursor;
+	}
+
+	bool SnapshotInput::IsFailed() const noexcept
+	{
+		return m_failed;
+	}
+
+	bool RegistrySnapshot::OpenOutput( const std::string& path, std::ofstream& file )
+	{
+		file.open( path, std::ios::out | std::ios::binary | std::ios::trunc );
+		return static_cast<bool>(file);
+	}
+
+	void RegistrySnapshot::WriteHeader( SnapshotOutput& out )
+	{
+		out.Write( snapshotMagic, sizeof( snapshotMagic ) );
+		out( snapshotVersion );
+	}
+
+	bool RegistrySnapshot::ReadHeader( SnapshotInput& in )
+	{
+		const std::byte* magic = in.Take( sizeof( snapshotMagic ) );
+		uint32_t version = 0u;
+		in( version );
+		return magic && std::memcmp( magic, snapshotMagic, sizeof( snapshotMagic ) ) == 0 && version == snapshotVersion;
+	}
+}
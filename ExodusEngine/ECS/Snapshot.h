@@ -0,0 +1,274 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Registry.h"
+#include "Support/MappedFile.h"
+
+namespace Exodus
+{
+	// Streaming archive for entt::basic_snapshot. Values go through a fixed buffer to the
+	// stream, large blocks are written straight through, so a snapshot never exists as one blob.
+	// Trivially copyable values are stored as raw bytes, anything else needs an ADL overload
+	//   void Serialize( SnapshotOutput& out, const MyComponent& value );
+	class SnapshotOutput
+	{
+	public:
+		explicit SnapshotOutput( std::ostream& stream );
+		~SnapshotOutput();
+		SnapshotOutput( const SnapshotOutput& ) = delete;
+		SnapshotOutput& operator=( const SnapshotOutput& ) = delete;
+
+		template<typename T>
+		void operator()( const T& value )
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				Write( &value, sizeof( T ) );
+			}
+			else
+			{
+				Serialize( *this, value );
+			}
+		}
+		void Write( const void* data, size_t bytes );
+		void WriteString( const std::string& text );
+		// pads with zeros up to a multiple of alignment from the start of the stream
+		void Align( size_t alignment );
+		void Flush();
+		bool IsGood() const noexcept;
+	private:
+		std::ostream& m_stream;
+		std::vector<std::byte> m_buffer;
+		size_t m_used = 0u;
+		uint64_t m_offset = 0u;
+	};
+
+	// Counterpart of SnapshotOutput over memory, usually a MappedFile. Reading past the end
+	// leaves the value zeroed and the archive failed. Non trivially copyable values need
+	//   void Deserialize( SnapshotInput& in, MyComponent& value );
+	class SnapshotInput
+	{
+	public:
+		SnapshotInput( const std::byte* data, size_t size ) noexcept;
+
+		template<typename T>
+		void operator()( T& value )
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				Read( &value, sizeof( T ) );
+			}
+			else
+			{
+				Deserialize( *this, value );
+			}
+		}
+		void Read( void* data, size_t bytes ) noexcept;
+		std::string ReadString();
+		// pointer into the underlying memory, nullptr if fewer than bytes are left
+		const std::byte* Take( size_t bytes ) noexcept;
+		void Align( size_t alignment ) noexcept;
+		size_t GetRemaining() const noexcept;
+		bool IsFailed() const noexcept;
+	private:
+		const std::byte* m_data;
+		size_t m_size;
+		size_t m_cursor = 0u;
+		bool m_failed = false;
+	};
+
+	// Saves and restores the entities of a Registry plus the listed component types, in that
+	// order. Pools of trivially copyable components are written as two contiguous blocks (the
+	// packed entities, then the component pages) and loaded with a bulk insert straight from
+	// the file mapping; other types go through entt::basic_snapshot and Serialize/Deserialize.
+	//   RegistrySnapshot::Save<Position, Velocity, Name>( Entities, "level.snap" );
+	//   RegistrySnapshot::Load<Position, Velocity, Name>( Entities, "level.snap" );
+	class RegistrySnapshot
+	{
+	private:
+		enum class PoolMode : uint8_t
+		{
+			Block,
+			Archive,
+		};
+		static constexpr size_t blockAlignment = 64u;
+
+		template<typename T>
+		static constexpr bool isBlockCopyable = std::is_trivially_copyable_v<T>
+			&& Registry::storage_for_type<T>::storage_policy != entt::deletion_policy::in_place;
+	public:
+		template<typename... Component>
+		static bool Save( const Registry& registry, const std::string& path );
+		// registry must be empty
+		template<typename... Component>
+		static bool Load( Registry& registry, const std::string& path );
+	private:
+		static bool OpenOutput( const std::string& path, std::ofstream& file );
+		static void WriteHeader( SnapshotOutput& out );
+		static bool ReadHeader( SnapshotInput& in );
+
+		template<typename T>
+		static void SavePool( const Registry& registry, const entt::basic_snapshot<Registry>& snapshot, SnapshotOutput& out );
+		template<typename T>
+		static bool LoadPool( Registry& registry, entt::basic_snapshot_loader<Registry>& loader, SnapshotInput& in );
+	};
+
+	template<typename... Component>
+	bool RegistrySnapshot::Save( const Registry& registry, const std::string& path )
+	{
+		std::ofstream file;
+		if (!OpenOutput( path, file ))
+		{
+			return false;
+		}
+		SnapshotOutput out( file );
+		WriteHeader( out );
+		const entt::basic_snapshot<Registry> snapshot( registry );
+		snapshot.get<entt::entity>( out );
+		(SavePool<Component>( registry, snapshot, out ), ...);
+		out.Flush();
+		return out.IsGood();
+	}
+
+	template<typename... Component>
+	bool RegistrySnapshot::Load( Registry& registry, const std::string& path )
+	{
+		MappedFile file;
+		if (!file.Open( path ))
+		{
+			return false;
+		}
+		SnapshotInput in( file.GetData(), file.GetSize() );
+		if (!ReadHeader( in ))
+		{
+			return false;
+		}
+		entt::basic_snapshot_loader<Registry> loader( registry );
+		loader.get<entt::entity>( in );
+		return (LoadPool<Component>( registry, loader, in ) && ...) && !in.IsFailed();
+	}
+
+	template<typename T>
+	void RegistrySnapshot::SavePool( const Registry& registry, const entt::basic_snapshot<Registry>& snapshot, SnapshotOutput& out )
+	{
+		using Storage = Registry::storage_for_type<T>;
+		out( static_cast<uint32_t>(entt::type_hash<T>::value()) );
+		out( static_cast<uint32_t>(sizeof( T )) );
+		if constexpr (isBlockCopyable<T>)
+		{
+			const Storage* storage = registry.storage<T>();
+			const uint64_t count = storage ? storage->size() : 0u;
+			out( PoolMode::Block );
+			out( count );
+			if (count == 0u)
+			{
+				return;
+			}
+			out.Align( blockAlignment );
+			out.Write( storage->data(), count * sizeof( entt::entity ) );
+			if constexpr (entt::component_traits<T>::page_size != 0u)
+			{
+				constexpr size_t pageSize = entt::component_traits<T>::page_size;
+				out.Align( blockAlignment );
+				for (uint64_t first = 0u; first < count; first += pageSize)
+				{
+					const size_t elements = static_cast<size_t>(count - first < pageSize ? count - first : pageSize);
+					out.Write( storage->raw()[first / pageSize], elements * sizeof( T ) );
+				}
+			}
+		}
+		else
+		{
+			out( PoolMode::Archive );
+			snapshot.get<T>( out );
+		}
+	}
+
+	template<typename T>
+	bool RegistrySnapshot::LoadPool( Registry& registry, entt::basic_snapshot_loader<Registry>& loader, SnapshotInput& in )
+	{
+		uint32_t hash = 0u;
+		uint32_t size = 0u;
+		PoolMode mode = PoolMode::Archive;
+		in( hash );
+		in( size );
+		in( mode );
+		// component list or layout differs from the one the file was saved with
+		if (in.IsFailed() || hash != static_cast<uint32_t>(entt::type_hash<T>::value()) || size != sizeof( T ))
+		{
+			return false;
+		}
+		if (mode == PoolMode::Archive)
+		{
+			loader.get<T>( in );
+			return !in.IsFailed();
+		}
+		if constexpr (isBlockCopyable<T>)
+		{
+			constexpr size_t entryBytes = sizeof( entt::entity ) + (entt::component_traits<T>::page_size != 0u ? sizeof( T ) : 0u);
+			uint64_t count = 0u;
+			in( count );
+			// a corrupt count could wrap the sizes below or make reserve() throw
+			if (in.IsFailed() || count > in.GetRemaining() / entryBytes)
+			{
+				return false;
+			}
+			if (count == 0u)
+			{
+				return true;
+			}
+			in.Align( blockAlignment );
+			const auto* entities = reinterpret_cast<const entt::entity*>(in.Take( count * sizeof( entt::entity ) ));
+			if (!entities)
+			{
+				return false;
+			}
+			auto& storage = registry.storage<T>();
+			storage.reserve( storage.size() + count );
+			if constexpr (entt::component_traits<T>::page_size != 0u)
+			{
+				in.Align( blockAlignment );
+				const auto* components = reinterpret_cast<const T*>(in.Take( count * sizeof( T ) ));
+				if (!components)
+				{
+					return false;
+				}
+				storage.insert( entities, entities + count, components );
+			}
+			else
+			{
+				storage.insert( entities, entities + count );
+			}
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+}
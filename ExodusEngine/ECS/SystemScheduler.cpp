@@ -0,0 +1,137 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "SystemScheduler.h"
+#include "Profiling/Profiler.h"
+
+using namespace std::chrono;
+
+namespace Exodus
+{
+	SystemScheduler::SystemScheduler( Registry& registry, JobSystem& jobs )
+		:
+		m_registry( registry ),
+		m_jobs( jobs )
+	{
+	}
+
+	void SystemScheduler::Clear()
+	{
+		m_organizer.clear();
+		m_nodes.clear();
+		m_roots.clear();
+		m_dirty = false;
+	}
+
+	void SystemScheduler::Execute( float deltaTime )
+	{
+		if (m_dirty)
+		{
+			Build();
+		}
+		m_registry.ctx().insert_or_assign( FrameTime{ deltaTime } );
+		if (m_nodes.empty())
+		{
+			return;
+		}
+
+		const auto start = steady_clock::now();
+		for (auto& node : m_nodes)
+		{
+			node->pendingDependencies.store( static_cast<uint32_t>(node->vertex.in_edges().size()), std::memory_order_relaxed );
+		}
+		EXODUS_PROFILE_ZONE( "Systems" );
+		JobCounter counter;
+		for (size_t root : m_roots)
+		{
+			Dispatch( root, counter );
+		}
+		m_jobs.Wait( counter );
+		m_lastFrameTime = duration<float>( steady_clock::now() - start ).count();
+
+		m_lastSystemTime = 0.0f;
+		for (const auto& node : m_nodes)
+		{
+			m_lastSystemTime += node->lastTime;
+		}
+	}
+
+	size_t SystemScheduler::GetSystemCount() const noexcept
+	{
+		return m_nodes.size();
+	}
+
+	SystemScheduler::SystemStats SystemScheduler::GetStats( size_t index ) const noexcept
+	{
+		const Node& node = *m_nodes[index];
+		return { node.vertex.name(), node.vertex.ro_count(), node.vertex.rw_count(), node.lastTime };
+	}
+
+	float SystemScheduler::GetLastFrameTime() const noexcept
+	{
+		return m_lastFrameTime;
+	}
+
+	float SystemScheduler::GetParallelism() const noexcept
+	{
+		return m_lastFrameTime > 0.0f ? m_lastSystemTime / m_lastFrameTime : 0.0f;
+	}
+
+	void SystemScheduler::Build()
+	{
+		m_nodes.clear();
+		m_roots.clear();
+		for (auto& vertex : m_organizer.graph())
+		{
+			// creates missing storages and context variables up front, views are not
+			// allowed to do that once systems run on several threads
+			vertex.prepare( m_registry );
+			auto node = std::make_unique<Node>( std::move( vertex ) );
+			if (node->vertex.top_level())
+			{
+				m_roots.push_back( m_nodes.size() );
+			}
+			m_nodes.push_back( std::move( node ) );
+		}
+		m_dirty = false;
+	}
+
+	void SystemScheduler::Dispatch( size_t index, JobCounter& counter )
+	{
+		m_jobs.Run( [this, index, &counter]()
+		{
+			Node& node = *m_nodes[index];
+			const auto start = steady_clock::now();
+			{
+				EXODUS_PROFILE_ZONE( node.vertex.name() ? node.vertex.name() : "System" );
+				node.vertex.callback()(node.vertex.data(), m_registry);
+			}
+			node.lastTime = duration<float>( steady_clock::now() - start ).count();
+			// successors are queued before this job finishes, so the counter cannot hit zero early
+			for (size_t next : node.vertex.out_edges())
+			{
+				if (m_nodes[next]->pendingDependencies.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u)
+				{
+					Dispatch( next, counter );
+				}
+			}
+		}, &counter );
+	}
+}
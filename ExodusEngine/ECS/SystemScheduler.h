@@ -0,0 +1,101 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "Jobs/JobSystem.h"
+#include "Registry.h"
+
+namespace Exodus
+{
+	// Stored in the registry context before systems run, take it as `const FrameTime&`
+	struct FrameTime
+	{
+		float deltaTime = 0.0f;
+	};
+
+	// Systems are plain functions (or member functions with an instance) taking Views, the
+	// registry or context variables by reference. The read/write sets come from the
+	// constness of the parameters (entt::basic_organizer), systems that do not conflict run
+	// concurrently on the job system.
+	//   void Move( View<entt::get_t<Position, const Velocity>> view, const FrameTime& time );
+	//   scheduler.AddSystem<&Move>( "Move" );
+	class SystemScheduler
+	{
+	public:
+		struct SystemStats
+		{
+			const char* name = nullptr;
+			size_t readCount = 0u;
+			size_t writeCount = 0u;
+			float lastTime = 0.0f;
+		};
+	private:
+		using Organizer = entt::basic_organizer<Registry>;
+		struct Node
+		{
+			Organizer::vertex vertex;
+			std::atomic<uint32_t> pendingDependencies = 0u;
+			float lastTime = 0.0f;
+		};
+	public:
+		SystemScheduler( Registry& registry, JobSystem& jobs );
+		SystemScheduler( const SystemScheduler& ) = delete;
+		SystemScheduler& operator=( const SystemScheduler& ) = delete;
+
+		// Req overrides or extends the deduced access, e.g. AddSystem<&Fn, const Position>
+		template<auto System, typename... Req>
+		void AddSystem( const char* name = nullptr )
+		{
+			m_organizer.emplace<System, Req...>( name );
+			m_dirty = true;
+		}
+		template<auto System, typename... Req, typename Type>
+		void AddSystem( Type& instance, const char* name = nullptr )
+		{
+			m_organizer.emplace<System, Req...>( instance, name );
+			m_dirty = true;
+		}
+		void Clear();
+		// runs all systems for one frame and blocks until they finished
+		void Execute( float deltaTime );
+
+		size_t GetSystemCount() const noexcept;
+		SystemStats GetStats( size_t index ) const noexcept;
+		// wall clock of the last Execute()
+		float GetLastFrameTime() const noexcept;
+		// summed system time divided by wall clock, 1.0 means the systems ran serially
+		float GetParallelism() const noexcept;
+	private:
+		void Build();
+		void Dispatch( size_t index, JobCounter& counter );
+	private:
+		Registry& m_registry;
+		JobSystem& m_jobs;
+		Organizer m_organizer;
+		std::vector<std::unique_ptr<Node>> m_nodes;
+		std::vector<size_t> m_roots;
+		bool m_dirty = false;
+		float m_lastFrameTime = 0.0f;
+		float m_lastSystemTime = 0.0f;
+	};
+}
@@ -0,0 +1,320 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "InputLog.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr char logMagic[4] = { 'E', 'X', 'I', 'L' };
+		constexpr uint32_t logVersion = 1u;
+
+		void PutVarint( std::vector<uint8_t>& out, uint64_t value )
+		{
+			while (value >= 0x80u)
+			{
+				out.push_back( static_cast<uint8_t>(value | 0x80u) );
+				value >>= 7;
+			}
+			out.push_back( static_cast<uint8_t>(value) );
+		}
+
+		void PutSigned( std::vector<uint8_t>& out, int64_t value )
+		{
+			PutVarint( out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63) );
+		}
+
+		void PutU32( std::vector<uint8_t>& out, uint32_t value )
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				out.push_back( static_cast<uint8_t>(value >> (i * 8)) );
+			}
+		}
+
+		int64_t TimeDelta( uint64_t time, uint64_t reference ) noexcept
+		{
+			return static_cast<int64_t>(time - reference);
+		}
+	}
+
+	bool InputRecorder::Open( const std::string& path )
+	{
+		Close();
+		m_file.open( path, std::ios::out | std::ios::binary | std::ios::trunc );
+		if (!m_file)
+		{
+			return false;
+		}
+		m_buffer.clear();
+		for (const char c : logMagic)
+		{
+			m_buffer.push_back( static_cast<uint8_t>(c) );
+		}
+		PutU32( m_buffer, logVersion );
+		m_file.write( reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size() );
+		m_bytesWritten = m_buffer.size();
+		m_lastTimestamp = 0u;
+		m_frameCount = 0u;
+		return static_cast<bool>(m_file);
+	}
+
+	bool InputRecorder::IsOpen() const noexcept
+	{
+		return m_file.is_open();
+	}
+
+	void InputRecorder::WriteFrame( const InputFrame& frame )
+	{
+		if (!m_file.is_open())
+		{
+			return;
+		}
+		m_buffer.clear();
+		PutVarint( m_buffer, frame.events.size() );
+		uint32_t dtBits;
+		std::memcpy( &dtBits, &frame.deltaTime, sizeof( dtBits ) );
+		PutU32( m_buffer, dtBits );
+		PutSigned( m_buffer, TimeDelta( frame.timestamp, m_lastTimestamp ) );
+		m_lastTimestamp = frame.timestamp;
+		for (const InputEvent& e : frame.events)
+		{
+			m_buffer.push_back( static_cast<uint8_t>(e.type) );
+			switch (e.type)
+			{
+			case InputEvent::Type::Key:
+			case InputEvent::Type::Button:
+				m_buffer.push_back( e.code );
+				m_buffer.push_back( e.down ? 1u : 0u );
+				PutSigned( m_buffer, TimeDelta( e.timestamp, frame.timestamp ) );
+				break;
+			case InputEvent::Type::Char:
+				m_buffer.push_back( e.code );
+				break;
+			case InputEvent::Type::MouseMove:
+				PutSigned( m_buffer, e.x );
+				PutSigned( m_buffer, e.y );
+				PutSigned( m_buffer, TimeDelta( e.timestamp, frame.timestamp ) );
+				break;
+			case InputEvent::Type::MouseInWindow:
+				m_buffer.push_back( e.down ? 1u : 0u );
+				break;
+			case InputEvent::Type::Wheel:
+				PutSigned( m_buffer, e.x );
+				break;
+			case InputEvent::Type::RawDelta:
+				PutSigned( m_buffer, e.x );
+				PutSigned( m_buffer, e.y );
+				break;
+			}
+		}
+		m_file.write( reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size() );
+		m_bytesWritten += m_buffer.size();
+		++m_frameCount;
+	}
+
+	void InputRecorder::Close()
+	{
+		if (m_file.is_open())
+		{
+			m_file.close();
+		}
+	}
+
+	uint64_t InputRecorder::GetFrameCount() const noexcept
+	{
+		return m_frameCount;
+	}
+
+	uint64_t InputRecorder::GetBytesWritten() const noexcept
+	{
+		return m_bytesWritten;
+	}
+
+	bool InputPlayer::Open( const std::string& path )
+	{
+		std::ifstream file( path, std::ios::in | std::ios::binary );
+		if (!file)
+		{
+			return false;
+		}
+		m_data.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+		m_cursor = 0u;
+		m_lastTimestamp = 0u;
+		m_frameIndex = 0u;
+		if (m_data.size() < 8u || std::memcmp( m_data.data(), logMagic, sizeof( logMagic ) ) != 0)
+		{
+			m_data.clear();
+			return false;
+		}
+		uint32_t version = 0u;
+		for (int i = 0; i < 4; ++i)
+		{
+			version |= static_cast<uint32_t>(m_data[4 + i]) << (i * 8);
+		}
+		if (version != logVersion)
+		{
+			m_data.clear();
+			return false;
+		}
+		m_cursor = 8u;
+		return true;
+	}
+
+	bool InputPlayer::ReadFrame( InputFrame& frame )
+	{
+		frame.events.clear();
+		uint64_t eventCount;
+		if (!ReadVarint( eventCount ) || m_data.size() - m_cursor < 4u)
+		{
+			return false;
+		}
+		uint32_t dtBits = 0u;
+		for (int i = 0; i < 4; ++i)
+		{
+			dtBits |= static_cast<uint32_t>(m_data[m_cursor++]) << (i * 8);
+		}
+		std::memcpy( &frame.deltaTime, &dtBits, sizeof( dtBits ) );
+		int64_t delta;
+		if (!ReadSigned( delta ))
+		{
+			return false;
+		}
+		frame.timestamp = m_lastTimestamp + static_cast<uint64_t>(delta);
+		m_lastTimestamp = frame.timestamp;
+
+		for (uint64_t i = 0u; i < eventCount; ++i)
+		{
+			InputEvent e;
+			uint8_t type, flag;
+			int64_t a, b;
+			if (!ReadByte( type ))
+			{
+				return false;
+			}
+			e.type = static_cast<InputEvent::Type>(type);
+			e.timestamp = frame.timestamp;
+			switch (e.type)
+			{
+			case InputEvent::Type::Key:
+			case InputEvent::Type::Button:
+				if (!ReadByte( e.code ) || !ReadByte( flag ) || !ReadSigned( a ))
+				{
+					return false;
+				}
+				e.down = flag != 0u;
+				e.timestamp = frame.timestamp + static_cast<uint64_t>(a);
+				break;
+			case InputEvent::Type::Char:
+				if (!ReadByte( e.code ))
+				{
+					return false;
+				}
+				break;
+			case InputEvent::Type::MouseMove:
+				if (!ReadSigned( a ) || !ReadSigned( b ) || !ReadSigned( delta ))
+				{
+					return false;
+				}
+				e.x = static_cast<int>(a);
+				e.y = static_cast<int>(b);
+				e.timestamp = frame.timestamp + static_cast<uint64_t>(delta);
+				break;
+			case InputEvent::Type::MouseInWindow:
+				if (!ReadByte( flag ))
+				{
+					return false;
+				}
+				e.down = flag != 0u;
+				break;
+			case InputEvent::Type::Wheel:
+				if (!ReadSigned( a ))
+				{
+					return false;
+				}
+				e.x = static_cast<int>(a);
+				break;
+			case InputEvent::Type::RawDelta:
+				if (!ReadSigned( a ) || !ReadSigned( b ))
+				{
+					return false;
+				}
+				e.x = static_cast<int>(a);
+				e.y = static_cast<int>(b);
+				break;
+			default:
+				// unknown event type, the rest of the log can't be trusted
+				return false;
+			}
+			frame.events.push_back( e );
+		}
+		++m_frameIndex;
+		return true;
+	}
+
+	uint64_t InputPlayer::GetFrameIndex() const noexcept
+	{
+		return m_frameIndex;
+	}
+
+	bool InputPlayer::ReadByte( uint8_t& value ) noexcept
+	{
+		if (m_cursor >= m_data.size())
+		{
+			return false;
+		}
+		value = m_data[m_cursor++];
+		return true;
+	}
+
+	bool InputPlayer::ReadVarint( uint64_t& value ) noexcept
+	{
+		value = 0u;
+		for (uint32_t shift = 0u; shift < 64u; shift += 7u)
+		{
+			uint8_t byte;
+			if (!ReadByte( byte ))
+			{
+				return false;
+			}
+			value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+			if ((byte & 0x80u) == 0u)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool InputPlayer::ReadSigned( int64_t& value ) noexcept
+	{
+		uint64_t raw;
+		if (!ReadVarint( raw ))
+		{
+			return false;
+		}
+		value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1u);
+		return true;
+	}
+}
@@ -0,0 +1,84 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "InputSnapshot.h"
+#include "Memory/TrackedAllocator.h"
+
+namespace Exodus
+{
+	// Everything a frame consumed from the outside world: its input events and its delta time.
+	struct InputFrame
+	{
+		float deltaTime = 0.0f;
+		uint64_t timestamp = 0u;
+		std::vector<InputEvent, TrackedAllocator<InputEvent, MemoryTag::Input>> events;
+	};
+
+	// Input log file layout, little endian:
+	//   header  "EXIL", uint32 version
+	//   frame   varint eventCount, float32 deltaTime (raw bits), zigzag timestamp delta to the previous frame
+	//   event   uint8 type, then per type
+	//             Key/Button     uint8 code, uint8 down, zigzag timestamp delta to the frame
+	//             Char           uint8 code
+	//             MouseMove      zigzag x, zigzag y, zigzag timestamp delta to the frame
+	//             MouseInWindow  uint8 down
+	//             Wheel          zigzag x
+	//             RawDelta       zigzag x, zigzag y
+	// Delta times are stored bit for bit, so a replay with a fixed timestep is deterministic.
+	class InputRecorder
+	{
+	public:
+		bool Open( const std::string& path );
+		bool IsOpen() const noexcept;
+		void WriteFrame( const InputFrame& frame );
+		void Close();
+		uint64_t GetFrameCount() const noexcept;
+		uint64_t GetBytesWritten() const noexcept;
+	private:
+		std::ofstream m_file;
+		std::vector<uint8_t> m_buffer;
+		uint64_t m_lastTimestamp = 0u;
+		uint64_t m_frameCount = 0u;
+		uint64_t m_bytesWritten = 0u;
+	};
+
+	class InputPlayer
+	{
+	public:
+		// loads the whole log, false if it is missing or not an input log
+		bool Open( const std::string& path );
+		// false once the log is exhausted or truncated
+		bool ReadFrame( InputFrame& frame );
+		uint64_t GetFrameIndex() const noexcept;
+	private:
+		bool ReadByte( uint8_t& value ) noexcept;
+		bool ReadVarint( uint64_t& value ) noexcept;
+		bool ReadSigned( int64_t& value ) noexcept;
+	private:
+		std::vector<uint8_t> m_data;
+		size_t m_cursor = 0u;
+		uint64_t m_lastTimestamp = 0u;
+		uint64_t m_frameIndex = 0u;
+	};
+}
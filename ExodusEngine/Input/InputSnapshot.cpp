@@ -0,0 +1,138 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "InputSnapshot.h"
+
+namespace Exodus
+{
+	void InputSnapshotBuilder::Begin( uint64_t timestamp ) noexcept
+	{
+		m_snapshot.frameIndex = m_frameIndex++;
+		m_snapshot.timestamp = timestamp;
+		m_snapshot.previousKeys = m_snapshot.keys;
+		m_snapshot.previousButtons = m_snapshot.buttons;
+		m_snapshot.textLength = 0u;
+		m_snapshot.rawDeltaX = 0;
+		m_snapshot.rawDeltaY = 0;
+		m_snapshot.wheel = 0;
+		m_pressEvents.reset();
+		m_releaseEvents.reset();
+		m_buttonPressEvents = 0u;
+		m_buttonReleaseEvents = 0u;
+	}
+
+	void InputSnapshotBuilder::OnKey( unsigned char keycode, bool down, uint64_t timestamp ) noexcept
+	{
+		m_snapshot.keys[keycode] = down;
+		(down ? m_pressEvents : m_releaseEvents)[keycode] = true;
+		m_snapshot.keyTimestamps[keycode] = timestamp;
+	}
+
+	void InputSnapshotBuilder::OnChar( char character ) noexcept
+	{
+		if (m_snapshot.textLength < InputSnapshot::maxChars)
+		{
+			m_snapshot.text[m_snapshot.textLength++] = character;
+		}
+	}
+
+	void InputSnapshotBuilder::OnButton( InputSnapshot::Button button, bool down, uint64_t timestamp ) noexcept
+	{
+		if (down)
+		{
+			m_snapshot.buttons |= button;
+			m_buttonPressEvents |= button;
+		}
+		else
+		{
+			m_snapshot.buttons &= ~button;
+			m_buttonReleaseEvents |= button;
+		}
+		m_snapshot.mouseTimestamp = timestamp;
+	}
+
+	void InputSnapshotBuilder::OnMouseMove( int x, int y, uint64_t timestamp ) noexcept
+	{
+		m_snapshot.mouseX = x;
+		m_snapshot.mouseY = y;
+		m_snapshot.mouseTimestamp = timestamp;
+	}
+
+	void InputSnapshotBuilder::OnMouseInWindow( bool inWindow ) noexcept
+	{
+		m_snapshot.mouseInWindow = inWindow;
+	}
+
+	void InputSnapshotBuilder::OnWheel( int notches ) noexcept
+	{
+		m_snapshot.wheel += notches;
+	}
+
+	void InputSnapshotBuilder::OnRawDelta( int dx, int dy ) noexcept
+	{
+		m_snapshot.rawDeltaX += dx;
+		m_snapshot.rawDeltaY += dy;
+	}
+
+	void InputSnapshotBuilder::Apply( const InputEvent& e ) noexcept
+	{
+		switch (e.type)
+		{
+		case InputEvent::Type::Key:
+			OnKey( e.code, e.down, e.timestamp );
+			break;
+		case InputEvent::Type::Char:
+			OnChar( static_cast<char>(e.code) );
+			break;
+		case InputEvent::Type::Button:
+			OnButton( static_cast<InputSnapshot::Button>(e.code), e.down, e.timestamp );
+			break;
+		case InputEvent::Type::MouseMove:
+			OnMouseMove( e.x, e.y, e.timestamp );
+			break;
+		case InputEvent::Type::MouseInWindow:
+			OnMouseInWindow( e.down );
+			break;
+		case InputEvent::Type::Wheel:
+			OnWheel( e.x );
+			break;
+		case InputEvent::Type::RawDelta:
+			OnRawDelta( e.x, e.y );
+			break;
+		}
+	}
+
+	const InputSnapshot& InputSnapshotBuilder::End() noexcept
+	{
+		// autorepeat presses of held keys are not edges; a release counts if the key was down
+		// at the last snapshot or went down during this frame
+		InputSnapshot& s = m_snapshot;
+		s.pressed = m_pressEvents & ~s.previousKeys;
+		s.released = m_releaseEvents & (s.previousKeys | m_pressEvents);
+		s.buttonsPressed = static_cast<uint8_t>(m_buttonPressEvents & ~s.previousButtons);
+		s.buttonsReleased = static_cast<uint8_t>(m_buttonReleaseEvents & (s.previousButtons | m_buttonPressEvents));
+		return s;
+	}
+
+	const InputSnapshot& InputSnapshotBuilder::Get() const noexcept
+	{
+		return m_snapshot;
+	}
+}
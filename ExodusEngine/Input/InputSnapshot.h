@@ -0,0 +1,139 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+namespace Exodus
+{
+	// Input state as of the start of a frame. Built once per frame by EngineApplication::Run
+	// from the queued Keyboard/Mouse events, so it stays constant while HandleInput, Update and
+	// the systems run. Timestamps are ExodusTimer::Now() nanoseconds.
+	struct InputSnapshot
+	{
+		static constexpr unsigned int nKeys = 256u;
+		static constexpr unsigned int maxChars = 32u;
+		enum Button : uint8_t
+		{
+			Left = 1u << 0,
+			Right = 1u << 1,
+		};
+
+		uint64_t frameIndex = 0u;
+		uint64_t timestamp = 0u;
+		// keys down now and at the previous snapshot, pressed/released are the edges in between
+		// (a tap that went down and up within one frame shows up in both)
+		std::bitset<nKeys> keys;
+		std::bitset<nKeys> previousKeys;
+		std::bitset<nKeys> pressed;
+		std::bitset<nKeys> released;
+		// time of the last transition per key
+		std::array<uint64_t, nKeys> keyTimestamps = {};
+		// typed characters in order, anything past maxChars is dropped
+		std::array<char, maxChars> text = {};
+		uint32_t textLength = 0u;
+
+		int mouseX = 0;
+		int mouseY = 0;
+		bool mouseInWindow = false;
+		uint8_t buttons = 0u;
+		uint8_t previousButtons = 0u;
+		uint8_t buttonsPressed = 0u;
+		uint8_t buttonsReleased = 0u;
+		uint64_t mouseTimestamp = 0u;
+		// raw deltas summed over the frame
+		int rawDeltaX = 0;
+		int rawDeltaY = 0;
+		// wheel notches over the frame, positive is up
+		int wheel = 0;
+
+		bool KeyIsDown( unsigned char keycode ) const noexcept
+		{
+			return keys[keycode];
+		}
+		bool KeyWasPressed( unsigned char keycode ) const noexcept
+		{
+			return pressed[keycode];
+		}
+		bool KeyWasReleased( unsigned char keycode ) const noexcept
+		{
+			return released[keycode];
+		}
+		bool ButtonIsDown( Button button ) const noexcept
+		{
+			return (buttons & button) != 0u;
+		}
+		bool ButtonWasPressed( Button button ) const noexcept
+		{
+			return (buttonsPressed & button) != 0u;
+		}
+		bool ButtonWasReleased( Button button ) const noexcept
+		{
+			return (buttonsReleased & button) != 0u;
+		}
+	};
+
+	// One keyboard/mouse event in the form the snapshot builder and the input log use.
+	struct InputEvent
+	{
+		enum class Type : uint8_t
+		{
+			Key,			// code = keycode
+			Char,			// code = character
+			Button,			// code = InputSnapshot::Button
+			MouseMove,		// x, y = position
+			MouseInWindow,
+			Wheel,			// x = notches
+			RawDelta,		// x, y = delta
+		};
+		Type type = Type::Key;
+		uint8_t code = 0u;
+		bool down = false;
+		int x = 0;
+		int y = 0;
+		uint64_t timestamp = 0u;
+	};
+
+	// Folds one frame of input events into an InputSnapshot. Feed events in arrival order
+	// between Begin() and End(); state carries over from the previous frame.
+	class InputSnapshotBuilder
+	{
+	public:
+		void Begin( uint64_t timestamp ) noexcept;
+		void OnKey( unsigned char keycode, bool down, uint64_t timestamp ) noexcept;
+		void OnChar( char character ) noexcept;
+		void OnButton( InputSnapshot::Button button, bool down, uint64_t timestamp ) noexcept;
+		void OnMouseMove( int x, int y, uint64_t timestamp ) noexcept;
+		void OnMouseInWindow( bool inWindow ) noexcept;
+		void OnWheel( int notches ) noexcept;
+		void OnRawDelta( int dx, int dy ) noexcept;
+		void Apply( const InputEvent& e ) noexcept;
+		const InputSnapshot& End() noexcept;
+		const InputSnapshot& Get() const noexcept;
+	private:
+		InputSnapshot m_snapshot;
+		std::bitset<InputSnapshot::nKeys> m_pressEvents;
+		std::bitset<InputSnapshot::nKeys> m_releaseEvents;
+		uint8_t m_buttonPressEvents = 0u;
+		uint8_t m_buttonReleaseEvents = 0u;
+		uint64_t m_frameIndex = 0u;
+	};
+}
@@ -0,0 +1,312 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "JobSystem.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr uint32_t invalidThreadIndex = ~0u;
+		thread_local uint32_t t_threadIndex = invalidThreadIndex;
+	}
+
+	bool JobCounter::IsDone() const noexcept
+	{
+		return m_value.load( std::memory_order_acquire ) == 0u;
+	}
+
+	uint32_t JobCounter::GetValue() const noexcept
+	{
+		return m_value.load( std::memory_order_acquire );
+	}
+
+	JobSystem::JobSystem( uint32_t workerCount )
+	{
+		if (workerCount == 0u)
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1u ? hardwareThreads - 1u : 1u;
+		}
+		// the constructing thread is treated as the main thread and gets queue 0
+		t_threadIndex = 0u;
+		for (uint32_t i = 0u; i <= workerCount; ++i)
+		{
+			m_queues.push_back( std::make_unique<WorkQueue>() );
+		}
+		for (uint32_t i = 1u; i <= workerCount; ++i)
+		{
+			m_workers.emplace_back( &JobSystem::WorkerLoop, this, i );
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Run( JobFunction task, JobCounter* counter )
+	{
+		if (counter)
+		{
+			counter->m_value.fetch_add( 1u, std::memory_order_relaxed );
+		}
+		Push( { std::move( task ), counter } );
+	}
+
+	void JobSystem::RunAfter( JobCounter& dependency, JobFunction task, JobCounter* counter )
+	{
+		if (counter)
+		{
+			counter->m_value.fetch_add( 1u, std::memory_order_relaxed );
+		}
+		{
+			std::lock_guard<std::mutex> lock( dependency.m_continuationMutex );
+			if (!dependency.IsDone())
+			{
+				dependency.m_continuations.push_back( [this, task = std::move( task ), counter]() mutable
+				{
+					Push( { std::move( task ), counter } );
+				} );
+				return;
+			}
+		}
+		Push( { std::move( task ), counter } );
+	}
+
+	void JobSystem::ParallelFor( uint32_t count, uint32_t batchSize, RangeFunction task, JobCounter* counter )
+	{
+		if (count == 0u)
+		{
+			return;
+		}
+		if (batchSize == 0u)
+		{
+			batchSize = std::max( 1u, count / GetThreadCount() );
+		}
+		// share one copy of the callable between all batches
+		auto shared = std::make_shared<RangeFunction>( std::move( task ) );
+		for (uint32_t begin = 0u; begin < count; begin += batchSize)
+		{
+			const uint32_t end = std::min( count, begin + batchSize );
+			Run( [shared, begin, end]()
+			{
+				(*shared)( begin, end );
+			}, counter );
+		}
+	}
+
+	void JobSystem::RunOnMainThread( JobFunction task, JobCounter* counter )
+	{
+		if (counter)
+		{
+			counter->m_value.fetch_add( 1u, std::memory_order_relaxed );
+		}
+		std::lock_guard<std::mutex> lock( m_mainThreadMutex );
+		m_mainThreadJobs.push_back( { std::move( task ), counter } );
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mainThreadMutex );
+			std::swap( m_mainThreadJobs, m_mainThreadSwap );
+		}
+		for (Job& job : m_mainThreadSwap)
+		{
+			Execute( job );
+		}
+		m_mainThreadSwap.clear();
+	}
+
+	void JobSystem::Wait( JobCounter& counter )
+	{
+		const bool isMainThread = GetThreadIndex() == 0u;
+		while (!counter.IsDone())
+		{
+			if (isMainThread)
+			{
+				ProcessMainThreadJobs();
+			}
+			if (!TryExecuteOne())
+			{
+				std::this_thread::yield();
+			}
+		}
+		std::lock_guard<std::mutex> lock( counter.m_continuationMutex );
+	}
+
+	uint32_t JobSystem::GetWorkerCount() const noexcept
+	{
+		return static_cast<uint32_t>(m_workers.size());
+	}
+
+	uint32_t JobSystem::GetThreadCount() const noexcept
+	{
+		return static_cast<uint32_t>(m_queues.size());
+	}
+
+	uint32_t JobSystem::GetThreadIndex() noexcept
+	{
+		return t_threadIndex;
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_wakeMutex );
+			m_running = false;
+		}
+		m_wakeCondition.notify_all();
+		for (std::thread& worker : m_workers)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+		m_workers.clear();
+	}
+
+	void JobSystem::WorkerLoop( uint32_t index )
+	{
+		t_threadIndex = index;
+#if EXODUS_PROFILE
+		const std::string threadName = "Worker " + std::to_string( index );
+		EXODUS_PROFILE_THREAD( threadName.c_str() );
+#endif
+		while (m_running)
+		{
+			if (TryExecuteOne())
+			{
+				continue;
+			}
+			std::unique_lock<std::mutex> lock( m_wakeMutex );
+			m_wakeCondition.wait( lock, [this]()
+			{
+				return !m_running || m_pendingJobs.load( std::memory_order_acquire ) > 0u;
+			} );
+		}
+	}
+
+	void JobSystem::Push( Job job )
+	{
+		uint32_t index = GetThreadIndex();
+		if (index >= m_queues.size())
+		{
+			index = m_nextQueue.fetch_add( 1u, std::memory_order_relaxed ) % GetThreadCount();
+		}
+		m_pendingJobs.fetch_add( 1u, std::memory_order_release );
+		{
+			std::lock_guard<std::mutex> lock( m_queues[index]->mutex );
+			m_queues[index]->jobs.push_back( std::move( job ) );
+		}
+		// taking the lock orders this with a worker that is about to sleep, so the wake is not lost
+		{
+			std::lock_guard<std::mutex> lock( m_wakeMutex );
+		}
+		m_wakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryPop( uint32_t index, Job& job )
+	{
+		WorkQueue& queue = *m_queues[index];
+		std::lock_guard<std::mutex> lock( queue.mutex );
+		if (queue.jobs.empty())
+		{
+			return false;
+		}
+		job = std::move( queue.jobs.back() );
+		queue.jobs.pop_back();
+		return true;
+	}
+
+	bool JobSystem::TrySteal( uint32_t thief, Job& job )
+	{
+		const uint32_t queueCount = GetThreadCount();
+		const uint32_t start = thief < queueCount ? thief + 1u : 0u;
+		for (uint32_t i = 0u; i < queueCount; ++i)
+		{
+			const uint32_t victim = (start + i) % queueCount;
+			if (victim == thief)
+			{
+				continue;
+			}
+			WorkQueue& queue = *m_queues[victim];
+			std::unique_lock<std::mutex> lock( queue.mutex, std::try_to_lock );
+			if (!lock.owns_lock() || queue.jobs.empty())
+			{
+				continue;
+			}
+			job = std::move( queue.jobs.front() );
+			queue.jobs.pop_front();
+			return true;
+		}
+		return false;
+	}
+
+	bool JobSystem::TryExecuteOne()
+	{
+		if (m_pendingJobs.load( std::memory_order_acquire ) == 0u)
+		{
+			return false;
+		}
+		const uint32_t index = GetThreadIndex();
+		Job job;
+		if ((index < m_queues.size() && TryPop( index, job )) || TrySteal( index, job ))
+		{
+			m_pendingJobs.fetch_sub( 1u, std::memory_order_acq_rel );
+			Execute( job );
+			return true;
+		}
+		return false;
+	}
+
+	void JobSystem::Execute( Job& job )
+	{
+		job.task();
+		Finish( job.counter );
+	}
+
+	void JobSystem::Finish( JobCounter* counter )
+	{
+		if (!counter)
+		{
+			return;
+		}
+		// the counter may be destroyed by its waiter as soon as it reads zero, so it is not
+		// touched again once the lock is released (Wait() takes the same lock before returning)
+		std::vector<std::function<void()>> continuations;
+		{
+			std::lock_guard<std::mutex> lock( counter->m_continuationMutex );
+			if (counter->m_value.fetch_sub( 1u, std::memory_order_acq_rel ) == 1u)
+			{
+				std::swap( continuations, counter->m_continuations );
+			}
+		}
+		for (auto& continuation : continuations)
+		{
+			continuation();
+		}
+	}
+}
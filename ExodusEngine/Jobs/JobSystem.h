@@ -0,0 +1,112 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Exodus
+{
+	// Counts outstanding jobs. A job submitted with a counter increments it and decrements it
+	// when done, so waiting on a counter waits on a whole batch. Jobs can also be made to depend
+	// on a counter, they are queued once it reaches zero.
+	class JobCounter
+	{
+		friend class JobSystem;
+	public:
+		JobCounter() = default;
+		JobCounter( const JobCounter& ) = delete;
+		JobCounter& operator=( const JobCounter& ) = delete;
+		bool IsDone() const noexcept;
+		uint32_t GetValue() const noexcept;
+	private:
+		std::atomic<uint32_t> m_value = 0u;
+		std::mutex m_continuationMutex;
+		std::vector<std::function<void()>> m_continuations;
+	};
+
+	class JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+		using RangeFunction = std::function<void( uint32_t begin, uint32_t end )>;
+	private:
+		struct Job
+		{
+			JobFunction task;
+			JobCounter* counter = nullptr;
+		};
+		// each worker owns one, it pushes/pops at the back and thieves take from the front
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+	public:
+		// workerCount 0 picks hardware_concurrency - 1, the main thread helps out while waiting
+		explicit JobSystem( uint32_t workerCount = 0u );
+		~JobSystem();
+		JobSystem( const JobSystem& ) = delete;
+		JobSystem& operator=( const JobSystem& ) = delete;
+
+		void Run( JobFunction task, JobCounter* counter = nullptr );
+		// queues task once dependency reaches zero
+		void RunAfter( JobCounter& dependency, JobFunction task, JobCounter* counter = nullptr );
+		// splits [0, count) into batches of batchSize and runs them across the workers
+		void ParallelFor( uint32_t count, uint32_t batchSize, RangeFunction task, JobCounter* counter = nullptr );
+		// task is executed on the main thread the next time ProcessMainThreadJobs() runs
+		void RunOnMainThread( JobFunction task, JobCounter* counter = nullptr );
+		void ProcessMainThreadJobs();
+		// executes pending jobs on the calling thread until the counter reaches zero
+		void Wait( JobCounter& counter );
+
+		uint32_t GetWorkerCount() const noexcept;
+		uint32_t GetThreadCount() const noexcept;
+		// 0 is the main thread, workers are 1..GetWorkerCount(), ~0u for threads unknown to the system
+		static uint32_t GetThreadIndex() noexcept;
+		void Shutdown();
+	private:
+		void WorkerLoop( uint32_t index );
+		void Push( Job job );
+		bool TryPop( uint32_t index, Job& job );
+		bool TrySteal( uint32_t thief, Job& job );
+		bool TryExecuteOne();
+		void Execute( Job& job );
+		void Finish( JobCounter* counter );
+	private:
+		std::vector<std::unique_ptr<WorkQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+		std::atomic<bool> m_running = true;
+		std::atomic<uint32_t> m_pendingJobs = 0u;
+		std::atomic<uint32_t> m_nextQueue = 0u;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCondition;
+
+		std::mutex m_mainThreadMutex;
+		std::vector<Job> m_mainThreadJobs;
+		std::vector<Job> m_mainThreadSwap;
+	};
+}
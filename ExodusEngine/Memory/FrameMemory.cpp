@@ -0,0 +1,97 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "FrameMemory.h"
+#include "MemoryTracker.h"
+#include "Jobs/JobSystem.h"
+
+namespace Exodus
+{
+	FrameMemory::FrameMemory( uint32_t threadCount, size_t mainCapacity, size_t workerCapacity )
+	{
+		for (uint32_t i = 0u; i < threadCount; ++i)
+		{
+			m_arenas.push_back( std::make_unique<LinearArena>( i == 0u ? mainCapacity : workerCapacity, MemoryTracker::Get().GetResource( MemoryTag::Scratch ) ) );
+		}
+	}
+
+	LinearArena* FrameMemory::GetArena() noexcept
+	{
+		const uint32_t index = JobSystem::GetThreadIndex();
+		return index < m_arenas.size() ? m_arenas[index].get() : nullptr;
+	}
+
+	LinearArena& FrameMemory::GetArena( uint32_t threadIndex ) noexcept
+	{
+		return *m_arenas[threadIndex];
+	}
+
+	std::pmr::memory_resource* FrameMemory::GetResource() noexcept
+	{
+		if (LinearArena* arena = GetArena())
+		{
+			return arena;
+		}
+		return std::pmr::new_delete_resource();
+	}
+
+	void FrameMemory::Reset()
+	{
+		for (auto& arena : m_arenas)
+		{
+			arena->Reset();
+		}
+	}
+
+	uint32_t FrameMemory::GetArenaCount() const noexcept
+	{
+		return static_cast<uint32_t>(m_arenas.size());
+	}
+
+	size_t FrameMemory::GetUsed() const noexcept
+	{
+		size_t used = 0u;
+		for (const auto& arena : m_arenas)
+		{
+			used += arena->GetUsed();
+		}
+		return used;
+	}
+
+	size_t FrameMemory::GetHighWater() const noexcept
+	{
+		size_t highWater = 0u;
+		for (const auto& arena : m_arenas)
+		{
+			highWater += arena->GetHighWater();
+		}
+		return highWater;
+	}
+
+	uint64_t FrameMemory::GetOverflowCount() const noexcept
+	{
+		uint64_t count = 0u;
+		for (const auto& arena : m_arenas)
+		{
+			count += arena->GetOverflowCount();
+		}
+		return count;
+	}
+}
@@ -0,0 +1,58 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include "LinearArena.h"
+
+namespace Exodus
+{
+	// Scratch memory that lives for one frame. Every JobSystem thread (main thread and workers)
+	// gets its own LinearArena, so allocating needs no locking. EngineApplication::Run resets
+	// all of them at the start of each frame; nothing allocated here may be kept past the end
+	// of the frame, including from jobs still running then.
+	class FrameMemory
+	{
+	public:
+		static constexpr size_t defaultMainCapacity = 4u * 1024u * 1024u;
+		static constexpr size_t defaultWorkerCapacity = 256u * 1024u;
+	public:
+		// threadCount as in JobSystem::GetThreadCount()
+		explicit FrameMemory( uint32_t threadCount, size_t mainCapacity = defaultMainCapacity, size_t workerCapacity = defaultWorkerCapacity );
+		FrameMemory( const FrameMemory& ) = delete;
+		FrameMemory& operator=( const FrameMemory& ) = delete;
+
+		// arena of the calling thread, nullptr on threads the JobSystem doesn't know
+		LinearArena* GetArena() noexcept;
+		LinearArena& GetArena( uint32_t threadIndex ) noexcept;
+		// for pmr containers, falls back to the global heap on unknown threads
+		std::pmr::memory_resource* GetResource() noexcept;
+		void Reset();
+
+		uint32_t GetArenaCount() const noexcept;
+		// sums over all arenas
+		size_t GetUsed() const noexcept;
+		size_t GetHighWater() const noexcept;
+		uint64_t GetOverflowCount() const noexcept;
+	private:
+		std::vector<std::unique_ptr<LinearArena>> m_arenas;
+	};
+}
@@ -0,0 +1,133 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "LinearArena.h"
+
+#include <algorithm>
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr size_t blockAlignment = 64u;
+		// the block grows in these steps so a slowly rising high water mark doesn't reallocate every frame
+		constexpr size_t growGranularity = 64u * 1024u;
+	}
+
+	LinearArena::LinearArena( size_t capacity, std::pmr::memory_resource* upstream )
+		:
+		m_upstream( upstream ),
+		m_capacity( capacity )
+	{
+		if (m_capacity > 0u)
+		{
+			m_block = static_cast<std::byte*>(m_upstream->allocate( m_capacity, blockAlignment ));
+		}
+	}
+
+	LinearArena::~LinearArena()
+	{
+		ReleaseOverflow();
+		if (m_block)
+		{
+			m_upstream->deallocate( m_block, m_capacity, blockAlignment );
+		}
+	}
+
+	void* LinearArena::Allocate( size_t bytes, size_t alignment )
+	{
+		const uintptr_t base = reinterpret_cast<uintptr_t>(m_block);
+		const uintptr_t aligned = (base + m_offset + alignment - 1u) & ~(static_cast<uintptr_t>(alignment) - 1u);
+		const size_t end = static_cast<size_t>(aligned - base) + bytes;
+		if (m_block && end <= m_capacity)
+		{
+			m_offset = end;
+			return reinterpret_cast<void*>(aligned);
+		}
+		void* memory = m_upstream->allocate( bytes, alignment );
+		m_overflow.push_back( { memory, bytes, alignment } );
+		m_overflowBytes += bytes;
+		++m_overflowCount;
+		return memory;
+	}
+
+	void LinearArena::Reset()
+	{
+		m_highWater = std::max( m_highWater, GetUsed() );
+		if (!m_overflow.empty())
+		{
+			ReleaseOverflow();
+			// alignment padding isn't part of the high water mark, leave some headroom for it
+			const size_t wanted = m_highWater + m_highWater / 8u;
+			const size_t capacity = (wanted + growGranularity - 1u) / growGranularity * growGranularity;
+			if (m_block)
+			{
+				m_upstream->deallocate( m_block, m_capacity, blockAlignment );
+			}
+			m_block = static_cast<std::byte*>(m_upstream->allocate( capacity, blockAlignment ));
+			m_capacity = capacity;
+		}
+		m_offset = 0u;
+		m_overflowBytes = 0u;
+	}
+
+	size_t LinearArena::GetCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	size_t LinearArena::GetUsed() const noexcept
+	{
+		return m_offset + m_overflowBytes;
+	}
+
+	size_t LinearArena::GetHighWater() const noexcept
+	{
+		return std::max( m_highWater, GetUsed() );
+	}
+
+	uint64_t LinearArena::GetOverflowCount() const noexcept
+	{
+		return m_overflowCount;
+	}
+
+	void* LinearArena::do_allocate( size_t bytes, size_t alignment )
+	{
+		return Allocate( bytes, alignment );
+	}
+
+	void LinearArena::do_deallocate( void*, size_t, size_t )
+	{
+	}
+
+	bool LinearArena::do_is_equal( const std::pmr::memory_resource& other ) const noexcept
+	{
+		return this == &other;
+	}
+
+	void LinearArena::ReleaseOverflow()
+	{
+		for (const Overflow& overflow : m_overflow)
+		{
+			m_upstream->deallocate( overflow.memory, overflow.bytes, overflow.alignment );
+		}
+		m_overflow.clear();
+	}
+}
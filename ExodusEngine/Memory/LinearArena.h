@@ -0,0 +1,77 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Exodus
+{
+	// Bump allocator over one block, everything is released at once by Reset(). Deallocation is
+	// a no-op. When the block runs out requests go to the upstream resource and the block is
+	// grown to the high water mark on the next Reset(), so a steady workload stops allocating.
+	// Usable directly or as a std::pmr::memory_resource for pmr containers.
+	class LinearArena : public std::pmr::memory_resource
+	{
+	private:
+		struct Overflow
+		{
+			void* memory;
+			size_t bytes;
+			size_t alignment;
+		};
+	public:
+		explicit LinearArena( size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource() );
+		~LinearArena();
+		LinearArena( const LinearArena& ) = delete;
+		LinearArena& operator=( const LinearArena& ) = delete;
+
+		void* Allocate( size_t bytes, size_t alignment = alignof(std::max_align_t) );
+		template<typename T>
+		T* AllocateArray( size_t count )
+		{
+			return static_cast<T*>(Allocate( sizeof( T ) * count, alignof(T) ));
+		}
+		void Reset();
+
+		size_t GetCapacity() const noexcept;
+		// bytes handed out since the last Reset(), overflow included
+		size_t GetUsed() const noexcept;
+		// most bytes used between two resets
+		size_t GetHighWater() const noexcept;
+		// requests that did not fit the block, since construction
+		uint64_t GetOverflowCount() const noexcept;
+	private:
+		void* do_allocate( size_t bytes, size_t alignment ) override;
+		void do_deallocate( void* p, size_t bytes, size_t alignment ) override;
+		bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override;
+		void ReleaseOverflow();
+	private:
+		std::pmr::memory_resource* m_upstream;
+		std::byte* m_block = nullptr;
+		size_t m_capacity = 0u;
+		size_t m_offset = 0u;
+		size_t m_overflowBytes = 0u;
+		size_t m_highWater = 0u;
+		uint64_t m_overflowCount = 0u;
+		std::vector<Overflow> m_overflow;
+	};
+}
@@ -0,0 +1,183 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "MemoryTracker.h"
+
+#include <new>
+
+namespace Exodus
+{
+	namespace
+	{
+		// Allocate() keeps the size in front of the block, this keeps the block max aligned
+		constexpr size_t headerSize = alignof(std::max_align_t) > sizeof( size_t ) ? alignof(std::max_align_t) : sizeof( size_t );
+	}
+
+	MemoryTracker::MemoryTracker()
+	{
+		for (size_t i = 0u; i < tagCount; ++i)
+		{
+			m_resources[i].tag = static_cast<MemoryTag>(i);
+		}
+	}
+
+	const char* MemoryTracker::GetTagName( MemoryTag tag ) noexcept
+	{
+		switch (tag)
+		{
+		case MemoryTag::General:
+			return "General";
+		case MemoryTag::ECS:
+			return "ECS";
+		case MemoryTag::ImGui:
+			return "ImGui";
+		case MemoryTag::Input:
+			return "Input";
+		case MemoryTag::GpuUpload:
+			return "GPU upload";
+		case MemoryTag::Scratch:
+			return "Scratch";
+		case MemoryTag::Assets:
+			return "Assets";
+		default:
+			return "Unknown";
+		}
+	}
+
+	void MemoryTracker::OnAllocate( MemoryTag tag, size_t bytes ) noexcept
+	{
+		Counters& c = m_counters[static_cast<size_t>(tag)];
+		const size_t live = c.liveBytes.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+		size_t peak = c.peakBytes.load( std::memory_order_relaxed );
+		while (live > peak && !c.peakBytes.compare_exchange_weak( peak, live, std::memory_order_relaxed ))
+		{
+		}
+		c.liveAllocations.fetch_add( 1u, std::memory_order_relaxed );
+		c.totalAllocations.fetch_add( 1u, std::memory_order_relaxed );
+		c.frameAllocations.fetch_add( 1u, std::memory_order_relaxed );
+		c.frameBytes.fetch_add( bytes, std::memory_order_relaxed );
+	}
+
+	void MemoryTracker::OnFree( MemoryTag tag, size_t bytes ) noexcept
+	{
+		Counters& c = m_counters[static_cast<size_t>(tag)];
+		c.liveBytes.fetch_sub( bytes, std::memory_order_relaxed );
+		c.liveAllocations.fetch_sub( 1u, std::memory_order_relaxed );
+	}
+
+	void* MemoryTracker::Allocate( MemoryTag tag, size_t bytes )
+	{
+		std::byte* block = static_cast<std::byte*>(::operator new( bytes + headerSize ));
+		*reinterpret_cast<size_t*>(block) = bytes;
+		OnAllocate( tag, bytes );
+		return block + headerSize;
+	}
+
+	void MemoryTracker::Free( MemoryTag tag, void* p ) noexcept
+	{
+		if (!p)
+		{
+			return;
+		}
+		std::byte* block = static_cast<std::byte*>(p) - headerSize;
+		OnFree( tag, *reinterpret_cast<size_t*>(block) );
+		::operator delete( block );
+	}
+
+	std::pmr::memory_resource* MemoryTracker::GetResource( MemoryTag tag ) noexcept
+	{
+		return &m_resources[static_cast<size_t>(tag)];
+	}
+
+	void MemoryTracker::FrameBoundary() noexcept
+	{
+		for (Counters& c : m_counters)
+		{
+			c.lastFrameAllocations.store( c.frameAllocations.exchange( 0u, std::memory_order_relaxed ), std::memory_order_relaxed );
+			c.lastFrameBytes.store( c.frameBytes.exchange( 0u, std::memory_order_relaxed ), std::memory_order_relaxed );
+		}
+	}
+
+	MemoryTracker::TagStats MemoryTracker::GetStats( MemoryTag tag ) const noexcept
+	{
+		const Counters& c = m_counters[static_cast<size_t>(tag)];
+		TagStats stats;
+		stats.liveBytes = c.liveBytes.load( std::memory_order_relaxed );
+		stats.peakBytes = c.peakBytes.load( std::memory_order_relaxed );
+		stats.liveAllocations = c.liveAllocations.load( std::memory_order_relaxed );
+		stats.totalAllocations = c.totalAllocations.load( std::memory_order_relaxed );
+		stats.frameAllocations = c.lastFrameAllocations.load( std::memory_order_relaxed );
+		stats.frameBytes = c.lastFrameBytes.load( std::memory_order_relaxed );
+		stats.budget = c.budget.load( std::memory_order_relaxed );
+		return stats;
+	}
+
+	size_t MemoryTracker::GetTotalLiveBytes() const noexcept
+	{
+		size_t total = 0u;
+		for (const Counters& c : m_counters)
+		{
+			total += c.liveBytes.load( std::memory_order_relaxed );
+		}
+		return total;
+	}
+
+	void MemoryTracker::SetBudget( MemoryTag tag, size_t bytes ) noexcept
+	{
+		m_counters[static_cast<size_t>(tag)].budget.store( bytes, std::memory_order_relaxed );
+	}
+
+	bool MemoryTracker::IsOverBudget( MemoryTag tag ) const noexcept
+	{
+		const Counters& c = m_counters[static_cast<size_t>(tag)];
+		const size_t budget = c.budget.load( std::memory_order_relaxed );
+		return budget != 0u && c.liveBytes.load( std::memory_order_relaxed ) > budget;
+	}
+
+	bool MemoryTracker::IsAnyOverBudget() const noexcept
+	{
+		for (size_t i = 0u; i < tagCount; ++i)
+		{
+			if (IsOverBudget( static_cast<MemoryTag>(i) ))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void* MemoryTracker::TagResource::do_allocate( size_t bytes, size_t alignment )
+	{
+		void* p = ::operator new( bytes, std::align_val_t( alignment ) );
+		MemoryTracker::Get().OnAllocate( tag, bytes );
+		return p;
+	}
+
+	void MemoryTracker::TagResource::do_deallocate( void* p, size_t bytes, size_t alignment )
+	{
+		MemoryTracker::Get().OnFree( tag, bytes );
+		::operator delete( p, std::align_val_t( alignment ) );
+	}
+
+	bool MemoryTracker::TagResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept
+	{
+		return this == &other;
+	}
+}
@@ -0,0 +1,119 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace Exodus
+{
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		ECS,
+		ImGui,
+		Input,
+		GpuUpload,
+		Scratch,
+		Assets,
+		Count,
+	};
+
+	// Live byte counts, peaks and per-frame allocation rates per subsystem tag. Allocations
+	// report in through TrackedAllocator, the per-tag memory resources or Allocate()/Free();
+	// counters are atomics so any thread may allocate. Budgets are advisory, soak tests poll
+	// IsOverBudget() and fail the run.
+	class MemoryTracker
+	{
+	public:
+		static constexpr size_t tagCount = static_cast<size_t>(MemoryTag::Count);
+		struct TagStats
+		{
+			size_t liveBytes = 0u;
+			size_t peakBytes = 0u;
+			uint64_t liveAllocations = 0u;
+			uint64_t totalAllocations = 0u;
+			// during the last completed frame
+			uint64_t frameAllocations = 0u;
+			size_t frameBytes = 0u;
+			// 0 is unlimited
+			size_t budget = 0u;
+		};
+	private:
+		struct alignas(64) Counters
+		{
+			std::atomic<size_t> liveBytes = 0u;
+			std::atomic<size_t> peakBytes = 0u;
+			std::atomic<uint64_t> liveAllocations = 0u;
+			std::atomic<uint64_t> totalAllocations = 0u;
+			std::atomic<uint64_t> frameAllocations = 0u;
+			std::atomic<size_t> frameBytes = 0u;
+			std::atomic<uint64_t> lastFrameAllocations = 0u;
+			std::atomic<size_t> lastFrameBytes = 0u;
+			std::atomic<size_t> budget = 0u;
+		};
+		// global heap memory resource that reports to one tag
+		class TagResource : public std::pmr::memory_resource
+		{
+		public:
+			MemoryTag tag = MemoryTag::General;
+		private:
+			void* do_allocate( size_t bytes, size_t alignment ) override;
+			void do_deallocate( void* p, size_t bytes, size_t alignment ) override;
+			bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override;
+		};
+	public:
+		static const char* GetTagName( MemoryTag tag ) noexcept;
+
+		void OnAllocate( MemoryTag tag, size_t bytes ) noexcept;
+		void OnFree( MemoryTag tag, size_t bytes ) noexcept;
+		// for callers that don't know the size on free (C style callbacks such as ImGui's)
+		void* Allocate( MemoryTag tag, size_t bytes );
+		void Free( MemoryTag tag, void* p ) noexcept;
+		std::pmr::memory_resource* GetResource( MemoryTag tag ) noexcept;
+
+		// closes the per-frame counters, called once per frame from the main thread
+		void FrameBoundary() noexcept;
+
+		TagStats GetStats( MemoryTag tag ) const noexcept;
+		size_t GetTotalLiveBytes() const noexcept;
+		void SetBudget( MemoryTag tag, size_t bytes ) noexcept;
+		bool IsOverBudget( MemoryTag tag ) const noexcept;
+		bool IsAnyOverBudget() const noexcept;
+	private:
+		std::array<Counters, tagCount> m_counters;
+		std::array<TagResource, tagCount> m_resources;
+
+		// Singleton
+	public:
+		MemoryTracker( const MemoryTracker& ) = delete;
+		MemoryTracker& operator=( const MemoryTracker& ) = delete;
+
+		inline static MemoryTracker& Get()
+		{
+			static MemoryTracker instance;
+			return instance;
+		}
+	private:
+		MemoryTracker();
+	};
+}
@@ -0,0 +1,126 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "MemoryWindow.h"
+#include "MemoryTracker.h"
+#include "PagePool.h"
+
+#include <cstdio>
+
+// imgui
+#include "imgui/imgui.h"
+
+namespace Exodus
+{
+	namespace
+	{
+		void FormatBytes( char* buffer, size_t size, size_t bytes )
+		{
+			if (bytes >= 1024u * 1024u)
+			{
+				std::snprintf( buffer, size, "%.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0) );
+			}
+			else if (bytes >= 1024u)
+			{
+				std::snprintf( buffer, size, "%.1f KB", static_cast<double>(bytes) / 1024.0 );
+			}
+			else
+			{
+				std::snprintf( buffer, size, "%zu B", bytes );
+			}
+		}
+
+		void BytesCell( size_t bytes )
+		{
+			char text[32];
+			FormatBytes( text, sizeof( text ), bytes );
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted( text );
+		}
+	}
+
+	void MemoryWindow::Draw( bool* open )
+	{
+		if (!ImGui::Begin( "Memory", open ))
+		{
+			ImGui::End();
+			return;
+		}
+		MemoryTracker& tracker = MemoryTracker::Get();
+		char total[32];
+		FormatBytes( total, sizeof( total ), tracker.GetTotalLiveBytes() );
+		ImGui::Text( "Tracked live memory %s", total );
+		const PagePool::Stats pool = PagePool::Get().GetStats();
+		char poolLive[32], poolSlabs[32];
+		FormatBytes( poolLive, sizeof( poolLive ), pool.liveBytes );
+		FormatBytes( poolSlabs, sizeof( poolSlabs ), pool.slabBytes );
+		ImGui::Text( "Page pool %s of %s in %llu slabs%s", poolLive, poolSlabs, static_cast<unsigned long long>(pool.slabCount), pool.largePages ? " (large pages)" : "" );
+
+		const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+		if (ImGui::BeginTable( "MemoryTags", 7, flags ))
+		{
+			ImGui::TableSetupColumn( "Tag" );
+			ImGui::TableSetupColumn( "Live" );
+			ImGui::TableSetupColumn( "Peak" );
+			ImGui::TableSetupColumn( "Allocations" );
+			ImGui::TableSetupColumn( "Allocs/frame" );
+			ImGui::TableSetupColumn( "Bytes/frame" );
+			ImGui::TableSetupColumn( "Budget" );
+			ImGui::TableHeadersRow();
+			for (size_t i = 0u; i < MemoryTracker::tagCount; ++i)
+			{
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				const MemoryTracker::TagStats stats = tracker.GetStats( tag );
+				const bool over = tracker.IsOverBudget( tag );
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				if (over)
+				{
+					ImGui::PushStyleColor( ImGuiCol_Text, ImVec4( 1.0f, 0.35f, 0.35f, 1.0f ) );
+				}
+				ImGui::TextUnformatted( MemoryTracker::GetTagName( tag ) );
+				BytesCell( stats.liveBytes );
+				BytesCell( stats.peakBytes );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%llu", static_cast<unsigned long long>(stats.liveAllocations) );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%llu", static_cast<unsigned long long>(stats.frameAllocations) );
+				BytesCell( stats.frameBytes );
+				ImGui::TableNextColumn();
+				if (stats.budget == 0u)
+				{
+					ImGui::TextUnformatted( "-" );
+				}
+				else
+				{
+					char budget[32];
+					FormatBytes( budget, sizeof( budget ), stats.budget );
+					ImGui::ProgressBar( static_cast<float>(static_cast<double>(stats.liveBytes) / static_cast<double>(stats.budget)), ImVec2( -1.0f, 0.0f ), budget );
+				}
+				if (over)
+				{
+					ImGui::PopStyleColor();
+				}
+			}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	}
+}
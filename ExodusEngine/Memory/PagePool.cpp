@@ -0,0 +1,266 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "PagePool.h"
+
+#if defined(_WIN32)
+#include "Support/WinInclude.h"
+#else
+#include <cstdlib>
+#include <sys/mman.h>
+#endif
+
+namespace Exodus
+{
+	namespace
+	{
+		size_t ClassIndex( size_t bytes ) noexcept
+		{
+			return (bytes + PagePool::blockGranularity - 1u) / PagePool::blockGranularity - 1u;
+		}
+
+		template<typename Slab>
+		void Link( Slab*& head, Slab* slab ) noexcept
+		{
+			slab->prev = nullptr;
+			slab->next = head;
+			if (head)
+			{
+				head->prev = slab;
+			}
+			head = slab;
+		}
+
+		template<typename Slab>
+		void Unlink( Slab*& head, Slab* slab ) noexcept
+		{
+			if (slab->prev)
+			{
+				slab->prev->next = slab->next;
+			}
+			else
+			{
+				head = slab->next;
+			}
+			if (slab->next)
+			{
+				slab->next->prev = slab->prev;
+			}
+			slab->next = nullptr;
+			slab->prev = nullptr;
+		}
+	}
+
+	void* PagePool::Allocate( size_t bytes )
+	{
+		const size_t index = ClassIndex( bytes );
+		const size_t blockSize = (index + 1u) * blockGranularity;
+		SizeClass& sizeClass = m_classes[index];
+		std::lock_guard<std::mutex> lock( sizeClass.mutex );
+		if (!sizeClass.partial)
+		{
+			Link( sizeClass.partial, AcquireSlab() );
+		}
+		Slab* slab = sizeClass.partial;
+		void* block;
+		if (slab->freeList)
+		{
+			block = slab->freeList;
+			slab->freeList = slab->freeList->next;
+		}
+		else
+		{
+			block = slab->cursor;
+			slab->cursor += blockSize;
+		}
+		++slab->liveBlocks;
+		// full, the tail that can't hold a block is given up
+		const std::byte* end = reinterpret_cast<const std::byte*>(slab) + slabSize;
+		if (!slab->freeList && static_cast<size_t>(end - slab->cursor) < blockSize)
+		{
+			Unlink( sizeClass.partial, slab );
+		}
+		m_liveBytes.fetch_add( blockSize, std::memory_order_relaxed );
+		return block;
+	}
+
+	void PagePool::Free( void* p, size_t bytes ) noexcept
+	{
+		if (!p)
+		{
+			return;
+		}
+		const size_t index = ClassIndex( bytes );
+		const size_t blockSize = (index + 1u) * blockGranularity;
+		Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t( slabSize - 1u ));
+		SizeClass& sizeClass = m_classes[index];
+		std::lock_guard<std::mutex> lock( sizeClass.mutex );
+		const std::byte* end = reinterpret_cast<const std::byte*>(slab) + slabSize;
+		const bool wasFull = !slab->freeList && static_cast<size_t>(end - slab->cursor) < blockSize;
+		FreeBlock* block = static_cast<FreeBlock*>(p);
+		block->next = slab->freeList;
+		slab->freeList = block;
+		m_liveBytes.fetch_sub( blockSize, std::memory_order_relaxed );
+		if (--slab->liveBlocks == 0u)
+		{
+			if (!wasFull)
+			{
+				Unlink( sizeClass.partial, slab );
+			}
+			ReleaseSlab( slab );
+		}
+		else if (wasFull)
+		{
+			Link( sizeClass.partial, slab );
+		}
+	}
+
+	void PagePool::SetLargePages( bool enabled )
+	{
+#if defined(_WIN32)
+		// without the privilege the allocation fails, probe once and stay on normal pages
+		if (enabled)
+		{
+			const size_t largePage = GetLargePageMinimum();
+			void* probe = largePage != 0u && slabSize % largePage == 0u
+				? VirtualAlloc( nullptr, slabSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE )
+				: nullptr;
+			if (!probe)
+			{
+				enabled = false;
+			}
+			else
+			{
+				VirtualFree( probe, 0u, MEM_RELEASE );
+			}
+		}
+#endif
+		m_largePages = enabled;
+	}
+
+	PagePool::Stats PagePool::GetStats() const noexcept
+	{
+		Stats stats;
+		stats.slabBytes = m_slabBytes.load( std::memory_order_relaxed );
+		stats.liveBytes = m_liveBytes.load( std::memory_order_relaxed );
+		stats.slabCount = m_slabCount.load( std::memory_order_relaxed );
+		stats.largePages = m_largePages;
+		return stats;
+	}
+
+	PagePool::Slab* PagePool::AcquireSlab()
+	{
+		Slab* slab = nullptr;
+		{
+			std::lock_guard<std::mutex> lock( m_emptyMutex );
+			if (m_emptySlabs)
+			{
+				slab = m_emptySlabs;
+				Unlink( m_emptySlabs, slab );
+				--m_emptyCount;
+			}
+		}
+		if (!slab)
+		{
+			slab = AllocateSlab();
+		}
+		slab->freeList = nullptr;
+		slab->cursor = reinterpret_cast<std::byte*>(slab) + blockGranularity;
+		slab->liveBlocks = 0u;
+		return slab;
+	}
+
+	void PagePool::ReleaseSlab( Slab* slab ) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_emptyMutex );
+			if (m_emptyCount < retainedSlabs)
+			{
+				Link( m_emptySlabs, slab );
+				++m_emptyCount;
+				return;
+			}
+		}
+		FreeSlab( slab );
+	}
+
+	PagePool::Slab* PagePool::AllocateSlab()
+	{
+		void* allocation = nullptr;
+		void* slab = nullptr;
+#if defined(_WIN32)
+		// large pages are aligned to their size
+		if (m_largePages)
+		{
+			allocation = VirtualAlloc( nullptr, slabSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+			slab = allocation;
+			if (slab && reinterpret_cast<uintptr_t>(slab) % slabSize != 0u)
+			{
+				VirtualFree( allocation, 0u, MEM_RELEASE );
+				slab = nullptr;
+			}
+		}
+		if (!slab)
+		{
+			// reserve twice the size and commit the aligned half, only address space is wasted
+			allocation = VirtualAlloc( nullptr, slabSize * 2u, MEM_RESERVE, PAGE_READWRITE );
+			if (allocation)
+			{
+				const uintptr_t aligned = (reinterpret_cast<uintptr_t>(allocation) + slabSize - 1u) & ~uintptr_t( slabSize - 1u );
+				slab = VirtualAlloc( reinterpret_cast<void*>(aligned), slabSize, MEM_COMMIT, PAGE_READWRITE );
+				if (!slab)
+				{
+					VirtualFree( allocation, 0u, MEM_RELEASE );
+				}
+			}
+		}
+#else
+		// 2 MB aligned so the kernel can back it with one transparent huge page
+		allocation = std::aligned_alloc( slabSize, slabSize );
+		slab = allocation;
+		if (slab && m_largePages)
+		{
+			madvise( slab, slabSize, MADV_HUGEPAGE );
+		}
+#endif
+		if (!slab)
+		{
+			throw std::bad_alloc();
+		}
+		m_slabBytes.fetch_add( slabSize, std::memory_order_relaxed );
+		m_slabCount.fetch_add( 1u, std::memory_order_relaxed );
+		Slab* header = new (slab) Slab();
+		header->allocation = allocation;
+		return header;
+	}
+
+	void PagePool::FreeSlab( Slab* slab ) noexcept
+	{
+		void* allocation = slab->allocation;
+		slab->~Slab();
+#if defined(_WIN32)
+		VirtualFree( allocation, 0u, MEM_RELEASE );
+#else
+		std::free( allocation );
+#endif
+		m_slabBytes.fetch_sub( slabSize, std::memory_order_relaxed );
+		m_slabCount.fetch_sub( 1u, std::memory_order_relaxed );
+	}
+}
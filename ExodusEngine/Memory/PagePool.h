@@ -0,0 +1,171 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include "MemoryTracker.h"
+
+namespace Exodus
+{
+	// Slab allocator for page sized blocks. Requests are rounded up to a multiple of blockGranularity
+	// and carved from 2 MB slabs, each serving one size at a time. The slab's header sits in its
+	// first block, found from any block by masking the address. A slab that empties goes back to a
+	// list shared by all sizes, a few are kept there so allocate/free churn doesn't reach the OS
+	// and the rest are released.
+	class PagePool
+	{
+	public:
+		static constexpr size_t blockGranularity = 4u * 1024u;
+		static constexpr size_t maxBlockSize = 256u * 1024u;
+		static constexpr size_t slabSize = 2u * 1024u * 1024u;
+		static constexpr size_t classCount = maxBlockSize / blockGranularity;
+		// empty slabs kept for reuse by any size
+		static constexpr size_t retainedSlabs = 4u;
+		struct Stats
+		{
+			size_t slabBytes = 0u;
+			size_t liveBytes = 0u;
+			uint64_t slabCount = 0u;
+			bool largePages = false;
+		};
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+		struct Slab
+		{
+			// in its size's list while it has room, in the empty list once it has no blocks out
+			Slab* next = nullptr;
+			Slab* prev = nullptr;
+			FreeBlock* freeList = nullptr;
+			// blocks past cursor were never handed out
+			std::byte* cursor = nullptr;
+			// what goes back to the OS, the slab itself unless it was aligned by hand
+			void* allocation = nullptr;
+			uint32_t liveBlocks = 0u;
+		};
+		static_assert(sizeof( Slab ) <= blockGranularity, "the slab header has to fit its first block");
+		struct SizeClass
+		{
+			std::mutex mutex;
+			Slab* partial = nullptr;
+		};
+	public:
+		static constexpr bool Serves( size_t bytes ) noexcept
+		{
+			return bytes >= blockGranularity && bytes <= maxBlockSize;
+		}
+		// bytes must satisfy Serves(), blocks are blockGranularity aligned
+		void* Allocate( size_t bytes );
+		void Free( void* p, size_t bytes ) noexcept;
+		// backs new slabs with large pages (Windows, needs SeLockMemoryPrivilege) or transparent
+		// huge pages (Linux). Off by default: faulting them in can stall on memory compaction,
+		// worth it for long running servers that allocate up front.
+		void SetLargePages( bool enabled );
+		Stats GetStats() const noexcept;
+	private:
+		// an empty slab from the shared list or the OS
+		Slab* AcquireSlab();
+		void ReleaseSlab( Slab* slab ) noexcept;
+		Slab* AllocateSlab();
+		void FreeSlab( Slab* slab ) noexcept;
+	private:
+		std::array<SizeClass, classCount> m_classes;
+		std::mutex m_emptyMutex;
+		Slab* m_emptySlabs = nullptr;
+		size_t m_emptyCount = 0u;
+		std::atomic<size_t> m_slabBytes = 0u;
+		std::atomic<size_t> m_liveBytes = 0u;
+		std::atomic<uint64_t> m_slabCount = 0u;
+		std::atomic<bool> m_largePages = false;
+
+		// Singleton
+	public:
+		PagePool( const PagePool& ) = delete;
+		PagePool& operator=( const PagePool& ) = delete;
+
+		inline static PagePool& Get()
+		{
+			static PagePool instance;
+			return instance;
+		}
+	private:
+		PagePool() = default;
+	};
+
+	// Standard allocator that sends page sized requests (EnTT's sparse and component pages) to
+	// the PagePool and everything else to the heap, both counted against Tag.
+	template<typename T, MemoryTag Tag>
+	class PoolAllocator
+	{
+		static_assert(alignof(T) <= PagePool::blockGranularity, "PoolAllocator can't align past a block");
+	public:
+		using value_type = T;
+		template<typename U>
+		struct rebind
+		{
+			using other = PoolAllocator<U, Tag>;
+		};
+	public:
+		PoolAllocator() noexcept = default;
+		template<typename U>
+		PoolAllocator( const PoolAllocator<U, Tag>& ) noexcept
+		{
+		}
+
+		T* allocate( size_t count )
+		{
+			const size_t bytes = count * sizeof( T );
+			MemoryTracker::Get().OnAllocate( Tag, bytes );
+			if (PagePool::Serves( bytes ))
+			{
+				return static_cast<T*>(PagePool::Get().Allocate( bytes ));
+			}
+			return static_cast<T*>(::operator new( bytes, std::align_val_t( alignof(T) ) ));
+		}
+		void deallocate( T* p, size_t count ) noexcept
+		{
+			const size_t bytes = count * sizeof( T );
+			MemoryTracker::Get().OnFree( Tag, bytes );
+			if (PagePool::Serves( bytes ))
+			{
+				PagePool::Get().Free( p, bytes );
+				return;
+			}
+			::operator delete( p, std::align_val_t( alignof(T) ) );
+		}
+
+		template<typename U>
+		bool operator==( const PoolAllocator<U, Tag>& ) const noexcept
+		{
+			return true;
+		}
+		template<typename U>
+		bool operator!=( const PoolAllocator<U, Tag>& ) const noexcept
+		{
+			return false;
+		}
+	};
+}
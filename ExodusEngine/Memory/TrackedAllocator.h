@@ -0,0 +1,107 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "MemoryTracker.h"
+
+namespace Exodus
+{
+	// Stateless standard allocator that counts its memory against a MemoryTracker tag.
+	//   std::vector<InputEvent, TrackedAllocator<InputEvent, MemoryTag::Input>> events;
+	template<typename T, MemoryTag Tag>
+	class TrackedAllocator
+	{
+	public:
+		using value_type = T;
+		// the tag is a non-type parameter, allocator_traits can't rebind that on its own
+		template<typename U>
+		struct rebind
+		{
+			using other = TrackedAllocator<U, Tag>;
+		};
+	public:
+		TrackedAllocator() noexcept = default;
+		template<typename U>
+		TrackedAllocator( const TrackedAllocator<U, Tag>& ) noexcept
+		{
+		}
+
+		T* allocate( size_t count )
+		{
+			const size_t bytes = count * sizeof( T );
+			T* p;
+			if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				p = static_cast<T*>(::operator new( bytes, std::align_val_t( alignof(T) ) ));
+			}
+			else
+			{
+				p = static_cast<T*>(::operator new( bytes ));
+			}
+			MemoryTracker::Get().OnAllocate( Tag, bytes );
+			return p;
+		}
+		void deallocate( T* p, size_t count ) noexcept
+		{
+			MemoryTracker::Get().OnFree( Tag, count * sizeof( T ) );
+			if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				::operator delete( p, std::align_val_t( alignof(T) ) );
+			}
+			else
+			{
+				::operator delete( p );
+			}
+		}
+
+		template<typename U>
+		bool operator==( const TrackedAllocator<U, Tag>& ) const noexcept
+		{
+			return true;
+		}
+		template<typename U>
+		bool operator!=( const TrackedAllocator<U, Tag>& ) const noexcept
+		{
+			return false;
+		}
+	};
+
+	// new/delete for long lived single objects, counted against a tag like TrackedAllocator.
+	// TrackedDelete() counts sizeof( T ), hand it the pointer as the type it was created with.
+	template<MemoryTag Tag, typename T, typename... Args>
+	T* TrackedNew( Args&&... args )
+	{
+		T* p = new T( std::forward<Args>( args )... );
+		MemoryTracker::Get().OnAllocate( Tag, sizeof( T ) );
+		return p;
+	}
+
+	template<MemoryTag Tag, typename T>
+	void TrackedDelete( T* p ) noexcept
+	{
+		if (p)
+		{
+			MemoryTracker::Get().OnFree( Tag, sizeof( T ) );
+			delete p;
+		}
+	}
+}
@@ -0,0 +1,226 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std::chrono;
+
+namespace Exodus
+{
+	namespace
+	{
+		double s_nanosecondsPerTick = 1.0;
+		thread_local void* t_threadBuffer = nullptr;
+
+		uint64_t ReadTicks() noexcept
+		{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count());
+#endif
+		}
+	}
+
+	Profiler::Profiler()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		// invariant tsc, measure its rate against the steady clock once
+		const auto clockStart = steady_clock::now();
+		const uint64_t tickStart = ReadTicks();
+		std::this_thread::sleep_for( milliseconds( 5 ) );
+		const uint64_t tickEnd = ReadTicks();
+		const auto clockEnd = steady_clock::now();
+		const double elapsed = static_cast<double>(duration_cast<nanoseconds>( clockEnd - clockStart ).count());
+		s_nanosecondsPerTick = elapsed / static_cast<double>(tickEnd - tickStart);
+#endif
+		m_frameStart = ReadTicks();
+	}
+
+	uint64_t Profiler::Now() noexcept
+	{
+		return ReadTicks();
+	}
+
+	double Profiler::TicksToNanoseconds( uint64_t ticks ) noexcept
+	{
+		return static_cast<double>(ticks) * s_nanosecondsPerTick;
+	}
+
+	double Profiler::TicksToMilliseconds( uint64_t ticks ) noexcept
+	{
+		return TicksToNanoseconds( ticks ) * 1e-6;
+	}
+
+	void Profiler::SetEnabled( bool enabled ) noexcept
+	{
+		m_enabled.store( enabled, std::memory_order_relaxed );
+	}
+
+	bool Profiler::IsEnabled() const noexcept
+	{
+		return m_enabled.load( std::memory_order_relaxed );
+	}
+
+	void Profiler::SetThreadName( const char* name )
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::lock_guard<std::mutex> lock( m_threadMutex );
+		buffer.name = name;
+	}
+
+	void Profiler::FrameBoundary()
+	{
+		const uint64_t now = ReadTicks();
+		FrameCapture& capture = m_captures[m_frameIndex % captureCount];
+		capture.frameIndex = m_frameIndex;
+		capture.start = m_frameStart;
+		capture.end = now;
+		capture.zones.clear();
+		Drain( capture );
+		++m_frameIndex;
+		m_frameStart = now;
+		if (m_frameListener)
+		{
+			m_frameListener( capture );
+		}
+	}
+
+	void Profiler::SetFrameListener( FrameListener listener )
+	{
+		m_frameListener = std::move( listener );
+	}
+
+	uint32_t Profiler::EnterZone() noexcept
+	{
+		return GetThreadBuffer().depth++;
+	}
+
+	void Profiler::LeaveZone( const char* name, uint64_t start, uint32_t depth ) noexcept
+	{
+		const uint64_t end = ReadTicks();
+		ThreadBuffer& buffer = GetThreadBuffer();
+		buffer.depth = depth;
+		const uint64_t written = buffer.written.load( std::memory_order_relaxed );
+		ZoneRecord& record = buffer.records[written & (threadCapacity - 1u)];
+		record.sequence.store( 0u, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		record.name.store( name, std::memory_order_relaxed );
+		record.start.store( start, std::memory_order_relaxed );
+		record.end.store( end, std::memory_order_relaxed );
+		record.depth.store( depth, std::memory_order_relaxed );
+		record.sequence.store( written + 1u, std::memory_order_release );
+		buffer.written.store( written + 1u, std::memory_order_release );
+	}
+
+	uint64_t Profiler::GetFrameIndex() const noexcept
+	{
+		return m_frameIndex;
+	}
+
+	const Profiler::FrameCapture* Profiler::GetCapture( uint32_t framesAgo ) const noexcept
+	{
+		if (framesAgo >= GetCaptureCount())
+		{
+			return nullptr;
+		}
+		return &m_captures[(m_frameIndex - 1u - framesAgo) % captureCount];
+	}
+
+	uint32_t Profiler::GetCaptureCount() const noexcept
+	{
+		return static_cast<uint32_t>(std::min<uint64_t>( m_frameIndex, captureCount ));
+	}
+
+	uint32_t Profiler::GetThreadCount() const
+	{
+		std::lock_guard<std::mutex> lock( m_threadMutex );
+		return static_cast<uint32_t>(m_threads.size());
+	}
+
+	std::string Profiler::GetThreadName( uint32_t threadIndex ) const
+	{
+		std::lock_guard<std::mutex> lock( m_threadMutex );
+		return threadIndex < m_threads.size() ? m_threads[threadIndex]->name : std::string();
+	}
+
+	uint64_t Profiler::GetDroppedZones() const noexcept
+	{
+		return m_droppedZones;
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+	{
+		if (!t_threadBuffer)
+		{
+			auto buffer = std::make_unique<ThreadBuffer>();
+			std::lock_guard<std::mutex> lock( m_threadMutex );
+			buffer->index = static_cast<uint32_t>(m_threads.size());
+			buffer->name = "Thread " + std::to_string( buffer->index );
+			t_threadBuffer = buffer.get();
+			m_threads.push_back( std::move( buffer ) );
+		}
+		return *static_cast<ThreadBuffer*>(t_threadBuffer);
+	}
+
+	void Profiler::Drain( FrameCapture& capture )
+	{
+		std::lock_guard<std::mutex> lock( m_threadMutex );
+		for (auto& thread : m_threads)
+		{
+			const uint64_t written = thread->written.load( std::memory_order_acquire );
+			// the thread lapped us, the oldest records are already overwritten
+			if (written - thread->read > threadCapacity)
+			{
+				m_droppedZones += written - thread->read - threadCapacity;
+				thread->read = written - threadCapacity;
+			}
+			for (; thread->read < written; ++thread->read)
+			{
+				// the owner can lap us while we copy, a record whose sequence isn't ours (or
+				// changed during the copy) is being overwritten and counts as dropped
+				const ZoneRecord& record = thread->records[thread->read & (threadCapacity - 1u)];
+				const uint64_t sequence = record.sequence.load( std::memory_order_acquire );
+				const Zone zone = {
+					record.name.load( std::memory_order_relaxed ),
+					record.start.load( std::memory_order_relaxed ),
+					record.end.load( std::memory_order_relaxed ),
+					thread->index,
+					record.depth.load( std::memory_order_relaxed ) };
+				std::atomic_thread_fence( std::memory_order_acquire );
+				if (sequence != thread->read + 1u || record.sequence.load( std::memory_order_relaxed ) != sequence)
+				{
+					++m_droppedZones;
+					continue;
+				}
+				capture.zones.push_back( zone );
+			}
+		}
+	}
+}
@@ -0,0 +1,176 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Define EXODUS_PROFILE=0 to compile every profiling macro away.
+#if !defined(EXODUS_PROFILE)
+#define EXODUS_PROFILE 1
+#endif
+
+namespace Exodus
+{
+	// Scoped CPU zone profiler. Every thread records finished zones into its own ring buffer
+	// (single producer, no locks), the main thread drains all rings once per frame into a
+	// ring of frame captures the overlay and exporters read from.
+	class Profiler
+	{
+	public:
+		struct Zone
+		{
+			const char* name;
+			uint64_t start;
+			uint64_t end;
+			uint32_t threadIndex;
+			uint32_t depth;
+		};
+		struct FrameCapture
+		{
+			uint64_t frameIndex = 0u;
+			uint64_t start = 0u;
+			uint64_t end = 0u;
+			std::vector<Zone> zones;
+		};
+		static constexpr uint32_t captureCount = 256u;
+		using FrameListener = std::function<void( const FrameCapture& )>;
+	private:
+		// sequence is the record's write index + 1 once it is complete and 0 while the owner
+		// is overwriting it, Drain() only keeps a copy taken between two matching sequences
+		struct ZoneRecord
+		{
+			std::atomic<uint64_t> sequence = 0u;
+			std::atomic<const char*> name = nullptr;
+			std::atomic<uint64_t> start = 0u;
+			std::atomic<uint64_t> end = 0u;
+			std::atomic<uint32_t> depth = 0u;
+		};
+		static constexpr uint32_t threadCapacity = 1u << 16;
+		struct ThreadBuffer
+		{
+			std::string name;
+			uint32_t index = 0u;
+			uint32_t depth = 0u;
+			std::atomic<uint64_t> written = 0u;
+			uint64_t read = 0u;
+			std::array<ZoneRecord, threadCapacity> records;
+		};
+	public:
+		// timestamps are raw ticks, convert with TicksToNanoseconds()
+		static uint64_t Now() noexcept;
+		static double TicksToNanoseconds( uint64_t ticks ) noexcept;
+		static double TicksToMilliseconds( uint64_t ticks ) noexcept;
+
+		void SetEnabled( bool enabled ) noexcept;
+		bool IsEnabled() const noexcept;
+		void SetThreadName( const char* name );
+		// closes the current frame capture and opens the next, call once per frame from the main thread
+		void FrameBoundary();
+		// called from FrameBoundary() with every completed capture, pass nullptr to remove
+		void SetFrameListener( FrameListener listener );
+
+		uint32_t EnterZone() noexcept;
+		void LeaveZone( const char* name, uint64_t start, uint32_t depth ) noexcept;
+
+		uint64_t GetFrameIndex() const noexcept;
+		// 0 is the last completed frame, up to captureCount - 1 frames back
+		const FrameCapture* GetCapture( uint32_t framesAgo ) const noexcept;
+		uint32_t GetCaptureCount() const noexcept;
+		uint32_t GetThreadCount() const;
+		std::string GetThreadName( uint32_t threadIndex ) const;
+		uint64_t GetDroppedZones() const noexcept;
+	private:
+		ThreadBuffer& GetThreadBuffer();
+		void Drain( FrameCapture& capture );
+	private:
+		std::atomic<bool> m_enabled = true;
+		mutable std::mutex m_threadMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+		std::array<FrameCapture, captureCount> m_captures;
+		uint64_t m_frameIndex = 0u;
+		uint64_t m_frameStart = 0u;
+		uint64_t m_droppedZones = 0u;
+		FrameListener m_frameListener;
+
+		// Singleton
+	public:
+		Profiler( const Profiler& ) = delete;
+		Profiler& operator=( const Profiler& ) = delete;
+
+		inline static Profiler& Get()
+		{
+			static Profiler instance;
+			return instance;
+		}
+	private:
+		Profiler();
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope( const char* name ) noexcept
+			:
+			name( name ),
+			enabled( Profiler::Get().IsEnabled() )
+		{
+			if (enabled)
+			{
+				depth = Profiler::Get().EnterZone();
+				start = Profiler::Now();
+			}
+		}
+		~ProfileScope()
+		{
+			if (enabled)
+			{
+				Profiler::Get().LeaveZone( name, start, depth );
+			}
+		}
+		ProfileScope( const ProfileScope& ) = delete;
+		ProfileScope& operator=( const ProfileScope& ) = delete;
+	private:
+		const char* name;
+		uint64_t start = 0u;
+		uint32_t depth = 0u;
+		bool enabled;
+	};
+}
+
+#if EXODUS_PROFILE
+#define EXODUS_PROFILE_CONCAT_INNER( a, b ) a##b
+#define EXODUS_PROFILE_CONCAT( a, b ) EXODUS_PROFILE_CONCAT_INNER( a, b )
+// name must outlive the capture (string literals)
+#define EXODUS_PROFILE_ZONE( name ) Exodus::ProfileScope EXODUS_PROFILE_CONCAT( exoProfileScope, __LINE__ )( name )
+#define EXODUS_PROFILE_FUNCTION() EXODUS_PROFILE_ZONE( __FUNCTION__ )
+#define EXODUS_PROFILE_FRAME() Exodus::Profiler::Get().FrameBoundary()
+#define EXODUS_PROFILE_THREAD( name ) Exodus::Profiler::Get().SetThreadName( name )
+#else
+#define EXODUS_PROFILE_ZONE( name )
+#define EXODUS_PROFILE_FUNCTION()
+#define EXODUS_PROFILE_FRAME()
+#define EXODUS_PROFILE_THREAD( name )
+#endif
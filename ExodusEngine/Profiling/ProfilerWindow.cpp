@@ -0,0 +1,147 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ProfilerWindow.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <functional>
+
+// imgui
+#include "imgui/imgui.h"
+
+namespace Exodus
+{
+	namespace
+	{
+		ImU32 ZoneColor( const char* name )
+		{
+			// stable colour per zone name
+			const size_t hash = std::hash<const void*>{}(name);
+			const float hue = static_cast<float>(hash % 360u) / 360.0f;
+			float r, g, b;
+			ImGui::ColorConvertHSVtoRGB( hue, 0.55f, 0.8f, r, g, b );
+			return ImGui::GetColorU32( ImVec4( r, g, b, 1.0f ) );
+		}
+	}
+
+	void ProfilerWindow::Draw( bool* open )
+	{
+		if (!ImGui::Begin( "Profiler", open ))
+		{
+			ImGui::End();
+			return;
+		}
+		Profiler& profiler = Profiler::Get();
+		const uint32_t captureCount = profiler.GetCaptureCount();
+		if (captureCount == 0u)
+		{
+			ImGui::TextUnformatted( "No frames captured yet" );
+			ImGui::End();
+			return;
+		}
+
+		if (ImGui::Checkbox( "Paused", &m_paused ))
+		{
+			// keep looking at the same frame when toggling
+			m_selectedFrame = profiler.GetFrameIndex() - 1u - m_selectedFrame;
+		}
+		uint64_t framesAgo = m_paused ? profiler.GetFrameIndex() - 1u - m_selectedFrame : m_selectedFrame;
+		if (framesAgo >= captureCount)
+		{
+			framesAgo = captureCount - 1u;
+		}
+		ImGui::SameLine();
+		ImGui::Text( "Zoom %.1fx  Dropped zones %llu", m_zoom, static_cast<unsigned long long>(profiler.GetDroppedZones()) );
+
+		// frame history, oldest on the left
+		float frameTimes[Profiler::captureCount];
+		for (uint32_t i = 0u; i < captureCount; ++i)
+		{
+			const Profiler::FrameCapture* capture = profiler.GetCapture( captureCount - 1u - i );
+			frameTimes[i] = static_cast<float>(Profiler::TicksToMilliseconds( capture->end - capture->start ));
+		}
+		const ImVec2 historySize( ImGui::GetContentRegionAvail().x, 60.0f );
+		ImGui::PlotHistogram( "##FrameTimes", frameTimes, static_cast<int>(captureCount), 0, "Frame time (ms)", 0.0f, FLT_MAX, historySize );
+		if (ImGui::IsItemClicked())
+		{
+			const float x = ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x;
+			const uint32_t clicked = std::min( captureCount - 1u, static_cast<uint32_t>(x / ImGui::GetItemRectSize().x * captureCount) );
+			framesAgo = captureCount - 1u - clicked;
+			m_selectedFrame = m_paused ? profiler.GetFrameIndex() - 1u - framesAgo : framesAgo;
+		}
+
+		const Profiler::FrameCapture& frame = *profiler.GetCapture( static_cast<uint32_t>(framesAgo) );
+		const double frameTime = Profiler::TicksToMilliseconds( frame.end - frame.start );
+		ImGui::Text( "Frame %llu  %.3f ms  %zu zones", static_cast<unsigned long long>(frame.frameIndex), frameTime, frame.zones.size() );
+
+		ImGui::BeginChild( "##Timeline", ImVec2( 0.0f, 0.0f ), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar );
+		if (ImGui::IsWindowHovered() && ImGui::GetIO().KeyCtrl && ImGui::GetIO().MouseWheel != 0.0f)
+		{
+			m_zoom = std::clamp( m_zoom * (ImGui::GetIO().MouseWheel > 0.0f ? 1.25f : 0.8f), 1.0f, 1000.0f );
+		}
+		const uint32_t threadCount = profiler.GetThreadCount();
+		std::vector<uint32_t> threadDepth( threadCount, 0u );
+		for (const Profiler::Zone& zone : frame.zones)
+		{
+			threadDepth[zone.threadIndex] = std::max( threadDepth[zone.threadIndex], zone.depth + 1u );
+		}
+
+		const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+		const float width = (ImGui::GetContentRegionAvail().x - 1.0f) * m_zoom;
+		const double pixelsPerMs = frameTime > 0.0 ? width / frameTime : 0.0;
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		ImVec2 cursor = ImGui::GetCursorScreenPos();
+		std::vector<float> threadTop( threadCount, 0.0f );
+		for (uint32_t t = 0u; t < threadCount; ++t)
+		{
+			if (threadDepth[t] == 0u)
+			{
+				continue;
+			}
+			drawList->AddText( cursor, ImGui::GetColorU32( ImGuiCol_Text ), profiler.GetThreadName( t ).c_str() );
+			threadTop[t] = cursor.y + rowHeight;
+			cursor.y += rowHeight * (threadDepth[t] + 1u);
+		}
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		for (const Profiler::Zone& zone : frame.zones)
+		{
+			const float x0 = origin.x + static_cast<float>(Profiler::TicksToMilliseconds( zone.start - std::min( zone.start, frame.start ) ) * pixelsPerMs);
+			const float x1 = std::max( x0 + 1.0f, origin.x + static_cast<float>(Profiler::TicksToMilliseconds( zone.end - std::min( zone.end, frame.start ) ) * pixelsPerMs) );
+			const float y0 = threadTop[zone.threadIndex] + zone.depth * rowHeight;
+			const ImVec2 min( x0, y0 );
+			const ImVec2 max( x1, y0 + rowHeight - 1.0f );
+			drawList->AddRectFilled( min, max, ZoneColor( zone.name ) );
+			if (x1 - x0 > 20.0f)
+			{
+				drawList->PushClipRect( min, max, true );
+				drawList->AddText( ImVec2( x0 + 2.0f, y0 ), IM_COL32_BLACK, zone.name );
+				drawList->PopClipRect();
+			}
+			if (ImGui::IsMouseHoveringRect( min, max ))
+			{
+				ImGui::SetTooltip( "%s\n%.3f ms", zone.name, Profiler::TicksToMilliseconds( zone.end - zone.start ) );
+			}
+		}
+		ImGui::Dummy( ImVec2( width, cursor.y - origin.y ) );
+		ImGui::EndChild();
+		ImGui::End();
+	}
+}
@@ -0,0 +1,37 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace Exodus
+{
+	// ImGui overlay for the Profiler: frame time history on top (click to pick a frame),
+	// one flame graph row per thread below. Ctrl + wheel zooms the timeline.
+	class ProfilerWindow
+	{
+	public:
+		void Draw( bool* open = nullptr );
+	private:
+		bool m_paused = false;
+		// absolute frame index while paused, otherwise frames back from the newest
+		uint64_t m_selectedFrame = 0u;
+		float m_zoom = 1.0f;
+	};
+}
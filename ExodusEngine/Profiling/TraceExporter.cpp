@@ -0,0 +1,210 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "TraceExporter.h"
+
+#include <fstream>
+#include <iomanip>
+
+namespace Exodus
+{
+	namespace
+	{
+		void WriteEscaped( std::ostream& out, const char* text )
+		{
+			for (; text && *text; ++text)
+			{
+				switch (*text)
+				{
+				case '"':
+					out << "\\\"";
+					break;
+				case '\\':
+					out << "\\\\";
+					break;
+				default:
+					if (static_cast<unsigned char>(*text) >= 0x20)
+					{
+						out << *text;
+					}
+					break;
+				}
+			}
+		}
+
+		double ToMicroseconds( uint64_t ticks, uint64_t origin )
+		{
+			return ticks > origin ? Profiler::TicksToNanoseconds( ticks - origin ) * 1e-3 : 0.0;
+		}
+	}
+
+	TraceExporter::~TraceExporter()
+	{
+		Shutdown();
+	}
+
+	void TraceExporter::SetWindow( float seconds )
+	{
+		m_window = seconds;
+		m_windowTicks = static_cast<uint64_t>(seconds * 1e9 / Profiler::TicksToNanoseconds( 1u ));
+		if (seconds <= 0.0f)
+		{
+			Profiler::Get().SetFrameListener( nullptr );
+			m_frames.clear();
+			return;
+		}
+		Profiler::Get().SetFrameListener( [this]( const Profiler::FrameCapture& capture )
+		{
+			RecordFrame( capture );
+		} );
+		if (!m_writer.joinable())
+		{
+			m_running = true;
+			m_writer = std::thread( &TraceExporter::WriterLoop, this );
+		}
+	}
+
+	float TraceExporter::GetWindow() const noexcept
+	{
+		return m_window;
+	}
+
+	bool TraceExporter::Dump( const std::string& path )
+	{
+		if (m_frames.empty() || !m_writer.joinable())
+		{
+			return false;
+		}
+		WriteRequest request;
+		request.path = path;
+		request.frames.assign( std::make_move_iterator( m_frames.begin() ), std::make_move_iterator( m_frames.end() ) );
+		m_frames.clear();
+		const uint32_t threadCount = Profiler::Get().GetThreadCount();
+		for (uint32_t i = 0u; i < threadCount; ++i)
+		{
+			request.threadNames.push_back( Profiler::Get().GetThreadName( i ) );
+		}
+		{
+			std::lock_guard<std::mutex> lock( m_writeMutex );
+			m_requests.push_back( std::move( request ) );
+		}
+		m_writeCondition.notify_one();
+		return true;
+	}
+
+	bool TraceExporter::DumpNow( const std::string& path )
+	{
+		// close the frame that was in progress so it ends up in the file too
+		Profiler::Get().FrameBoundary();
+		const bool queued = Dump( path );
+		WaitForWrites();
+		return queued;
+	}
+
+	void TraceExporter::WaitForWrites()
+	{
+		std::unique_lock<std::mutex> lock( m_writeMutex );
+		m_idleCondition.wait( lock, [this]()
+		{
+			return m_requests.empty() && !m_writing;
+		} );
+	}
+
+	void TraceExporter::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_writeMutex );
+			m_running = false;
+		}
+		m_writeCondition.notify_one();
+		if (m_writer.joinable())
+		{
+			m_writer.join();
+		}
+	}
+
+	void TraceExporter::RecordFrame( const Profiler::FrameCapture& capture )
+	{
+		m_frames.push_back( capture );
+		while (m_frames.size() > 1u && m_frames.back().end - m_frames.front().start > m_windowTicks)
+		{
+			m_frames.pop_front();
+		}
+	}
+
+	void TraceExporter::WriterLoop()
+	{
+		std::unique_lock<std::mutex> lock( m_writeMutex );
+		while (true)
+		{
+			m_writeCondition.wait( lock, [this]()
+			{
+				return !m_running || !m_requests.empty();
+			} );
+			// drain what is queued even when shutting down, a crash dump must reach the disk
+			if (m_requests.empty())
+			{
+				return;
+			}
+			WriteRequest request = std::move( m_requests.front() );
+			m_requests.pop_front();
+			m_writing = true;
+			lock.unlock();
+			Write( request );
+			lock.lock();
+			m_writing = false;
+			m_idleCondition.notify_all();
+		}
+	}
+
+	bool TraceExporter::Write( const WriteRequest& request )
+	{
+		std::ofstream out( request.path, std::ios::out | std::ios::trunc );
+		if (!out)
+		{
+			return false;
+		}
+		const uint64_t origin = request.frames.front().start;
+		out << std::fixed << std::setprecision( 3 );
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Exodus\"}}";
+		for (size_t t = 0u; t < request.threadNames.size(); ++t)
+		{
+			out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t << ",\"args\":{\"name\":\"";
+			WriteEscaped( out, request.threadNames[t].c_str() );
+			out << "\"}}";
+		}
+		for (const Profiler::FrameCapture& frame : request.frames)
+		{
+			out << ",\n{\"name\":\"Frame " << frame.frameIndex << "\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+				<< ToMicroseconds( frame.start, origin ) << "}";
+			for (const Profiler::Zone& zone : frame.zones)
+			{
+				out << ",\n{\"name\":\"";
+				WriteEscaped( out, zone.name );
+				out << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadIndex
+					<< ",\"ts\":" << ToMicroseconds( zone.start, origin )
+					<< ",\"dur\":" << ToMicroseconds( zone.end, zone.start ) << "}";
+			}
+		}
+		out << "\n]}\n";
+		return static_cast<bool>(out);
+	}
+}
@@ -0,0 +1,85 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Profiler.h"
+
+namespace Exodus
+{
+	// Keeps a rolling window of profiler captures and writes them as Chrome trace event JSON
+	// (chrome://tracing, ui.perfetto.dev). Files are written on a background thread, Dump()
+	// only hands the buffered frames over and returns.
+	class TraceExporter
+	{
+	private:
+		struct WriteRequest
+		{
+			std::string path;
+			std::vector<Profiler::FrameCapture> frames;
+			std::vector<std::string> threadNames;
+		};
+	public:
+		// starts recording the last `seconds` of frames, 0 stops recording
+		void SetWindow( float seconds );
+		float GetWindow() const noexcept;
+		// flushes the recorded window to path, the window starts empty again afterwards
+		bool Dump( const std::string& path );
+		// synchronous variant for error paths, call from the main thread
+		bool DumpNow( const std::string& path );
+		// blocks until every queued dump is on disk
+		void WaitForWrites();
+		void Shutdown();
+	private:
+		void RecordFrame( const Profiler::FrameCapture& capture );
+		void WriterLoop();
+		static bool Write( const WriteRequest& request );
+	private:
+		float m_window = 0.0f;
+		uint64_t m_windowTicks = 0u;
+		std::deque<Profiler::FrameCapture> m_frames;
+
+		std::thread m_writer;
+		std::mutex m_writeMutex;
+		std::condition_variable m_writeCondition;
+		std::condition_variable m_idleCondition;
+		std::deque<WriteRequest> m_requests;
+		bool m_writing = false;
+		bool m_running = true;
+
+		// Singleton
+	public:
+		TraceExporter( const TraceExporter& ) = delete;
+		TraceExporter& operator=( const TraceExporter& ) = delete;
+
+		inline static TraceExporter& Get()
+		{
+			static TraceExporter instance;
+			return instance;
+		}
+	private:
+		TraceExporter() = default;
+		~TraceExporter();
+	};
+}
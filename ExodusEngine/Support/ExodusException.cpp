@@ -62,6 +62,7 @@ namespace Exodus
 		return oss.str();
 	}
 
+#if defined(_WIN32)
 	HrException::HrException( int line, const char* file, HRESULT hr ) noexcept
 		:
 		ExodusException( line, file ),
@@ -117,6 +118,7 @@ namespace Exodus
 		LocalFree( pMsgBuf );
 		return errorString;
 	}
+#endif
 
 	const char* NoGfxException::GetType() const noexcept
 	{
@@ -19,7 +19,9 @@
 ******************************************************************************************/
 #pragma once
 #include "exopch.h"
+#if defined(_WIN32)
 #include "WinInclude.h"
+#endif
 #include <exception>
 
 
@@ -40,6 +42,7 @@ namespace Exodus
 	protected:
 		mutable std::string whatBuffer;
 	};
+#if defined(_WIN32)
 	class HrException : public ExodusException
 	{
 	public:
@@ -52,6 +55,7 @@ namespace Exodus
 	private:
 		HRESULT hr;
 	};
+#endif
 	class NoGfxException : public ExodusException
 	{
 	public:
@@ -60,10 +64,13 @@ namespace Exodus
 	};	
 }
 
+#if defined(_WIN32)
 #define EHWND_EXCEPT( hr ) Exodus::HrException( __LINE__,__FILE__,(hr) )
 #define EHWND_LAST_EXCEPT() Exodus::HrException( __LINE__,__FILE__,GetLastError() )
+#endif
 #define EHWND_NOGFX_EXCEPT() Exodus::NoGfxException( __LINE__,__FILE__ )
 
+#if defined(_WIN32)
 namespace Exodus
 {
 	inline void ThrowIfFailed( HRESULT hr )
@@ -73,4 +80,5 @@ namespace Exodus
 			throw EHWND_EXCEPT( hr );
 		}
 	}
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -41,4 +41,9 @@ namespace Exodus{
 	{
 		return duration<float>( steady_clock::now() - last ).count();
 	}
+
+	uint64_t ExodusTimer::Now() noexcept
+	{
+		return static_cast<uint64_t>(duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count());
+	}
 }
@@ -19,6 +19,7 @@
 ******************************************************************************************/
 #pragma once
 #include <chrono>
+#include <cstdint>
 
 namespace Exodus
 {
@@ -28,6 +29,8 @@ namespace Exodus
 		ExodusTimer() noexcept;
 		float Mark() noexcept;
 		float Peek() const noexcept;
+		// steady clock in nanoseconds, for stamping events
+		static uint64_t Now() noexcept;
 	private:
 		std::chrono::steady_clock::time_point last;
 	};
@@ -0,0 +1,531 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "FileWatcher.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+
+#if defined(_WIN32)
+#include "WinInclude.h"
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Exodus
+{
+	namespace
+	{
+		std::string NormalizeDirectory( const std::string& directory )
+		{
+			std::string path = std::filesystem::path( directory ).lexically_normal().generic_string();
+			if (path.size() > 1u && path.back() == '/')
+			{
+				path.pop_back();
+			}
+			return path.empty() ? std::string( "." ) : path;
+		}
+
+		std::string Join( const std::string& directory, std::string_view name )
+		{
+			if (directory == ".")
+			{
+				return std::string( name );
+			}
+			std::string path;
+			path.reserve( directory.size() + 1u + name.size() );
+			path += directory;
+			path += '/';
+			path += name;
+			return path;
+		}
+	}
+
+#if defined(_WIN32)
+	struct FileWatcher::Directory
+	{
+		std::string path;
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		bool recursive = false;
+		OVERLAPPED overlapped = {};
+		// ReadDirectoryChangesW fails on network shares with anything larger
+		alignas(DWORD) std::byte buffer[64u * 1024u];
+	};
+
+	namespace
+	{
+		constexpr DWORD notifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+	}
+#else
+	struct FileWatcher::Directory
+	{
+		std::string path;
+		int watch = -1;
+		bool recursive = false;
+		bool root = false;
+	};
+
+	namespace
+	{
+		constexpr uint32_t watchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_EXCL_UNLINK | IN_ONLYDIR;
+	}
+#endif
+
+	FileWatcher::FileWatcher( std::chrono::milliseconds debounce )
+		:
+		m_debounce( debounce )
+	{
+#if defined(_WIN32)
+		m_port = CreateIoCompletionPort( INVALID_HANDLE_VALUE, nullptr, 0u, 1u );
+		m_running = m_port != nullptr;
+#else
+		m_inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+		m_wake = eventfd( 0u, EFD_NONBLOCK | EFD_CLOEXEC );
+		m_running = m_inotify >= 0 && m_wake >= 0;
+#endif
+		if (m_running)
+		{
+			m_thread = std::thread( &FileWatcher::Run, this );
+		}
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	bool FileWatcher::Watch( const std::string& directory, bool recursive )
+	{
+		if (!m_running)
+		{
+			return false;
+		}
+		const std::string path = NormalizeDirectory( directory );
+#if defined(_WIN32)
+		HANDLE handle = CreateFileA( path.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr );
+		if (handle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		auto watched = std::make_unique<Directory>();
+		watched->path = path;
+		watched->handle = handle;
+		watched->recursive = recursive;
+		// the directory is the completion key
+		if (!CreateIoCompletionPort( handle, m_port, reinterpret_cast<ULONG_PTR>(watched.get()), 0u ))
+		{
+			CloseHandle( handle );
+			return false;
+		}
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if (!Issue( *watched ))
+		{
+			CloseHandle( handle );
+			return false;
+		}
+		m_directories.push_back( std::move( watched ) );
+		m_stats.directoryCount = m_directories.size();
+		return true;
+#else
+		std::lock_guard<std::mutex> lock( m_mutex );
+		Directory* watched = AddDirectory( path, recursive, false, Clock::now() );
+		if (!watched)
+		{
+			return false;
+		}
+		watched->root = true;
+		return true;
+#endif
+	}
+
+	void FileWatcher::Drain( std::vector<FileChange>& changes )
+	{
+		std::lock_guard<std::mutex> lock( m_readyMutex );
+		if (changes.empty())
+		{
+			changes.swap( m_ready );
+		}
+		else
+		{
+			std::move( m_ready.begin(), m_ready.end(), std::back_inserter( changes ) );
+			m_ready.clear();
+		}
+	}
+
+	FileWatcher::Stats FileWatcher::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		return m_stats;
+	}
+
+	void FileWatcher::Stop()
+	{
+		if (!m_running)
+		{
+			return;
+		}
+#if defined(_WIN32)
+		// a packet without an overlapped tells the thread to quit
+		PostQueuedCompletionStatus( m_port, 0u, 0u, nullptr );
+		m_thread.join();
+		for (const auto& directory : m_directories)
+		{
+			// the read still owns the buffer until the cancellation completed
+			DWORD size;
+			CancelIoEx( directory->handle, &directory->overlapped );
+			GetOverlappedResult( directory->handle, &directory->overlapped, &size, TRUE );
+			CloseHandle( directory->handle );
+		}
+		CloseHandle( m_port );
+		m_port = nullptr;
+#else
+		const uint64_t one = 1u;
+		static_cast<void>(write( m_wake, &one, sizeof( one ) ));
+		m_thread.join();
+		// closing the instance drops all of its watches
+		close( m_inotify );
+		close( m_wake );
+		m_inotify = -1;
+		m_wake = -1;
+		m_watches.clear();
+#endif
+		m_directories.clear();
+		m_pending.clear();
+		m_running = false;
+	}
+
+	void FileWatcher::Run()
+	{
+		EXODUS_PROFILE_THREAD( "FileWatcher" );
+		Clock::time_point next = Clock::time_point::max();
+		while (true)
+		{
+#if defined(_WIN32)
+			DWORD timeout = INFINITE;
+			if (next != Clock::time_point::max())
+			{
+				const auto wait = std::chrono::ceil<std::chrono::milliseconds>( next - Clock::now() ).count();
+				timeout = static_cast<DWORD>(std::max<long long>( wait, 0 ));
+			}
+			DWORD size = 0u;
+			ULONG_PTR key = 0u;
+			OVERLAPPED* overlapped = nullptr;
+			const BOOL succeeded = GetQueuedCompletionStatus( m_port, &size, &key, &overlapped, timeout );
+			const DWORD error = succeeded ? ERROR_SUCCESS : GetLastError();
+			if (!overlapped && succeeded)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> lock( m_mutex );
+			const Clock::time_point now = Clock::now();
+			if (overlapped)
+			{
+				Directory& directory = *reinterpret_cast<Directory*>(key);
+				// more changes than fit the buffer arrive as an empty result or ERROR_NOTIFY_ENUM_DIR
+				const bool overflowed = succeeded ? size == 0u : error == ERROR_NOTIFY_ENUM_DIR;
+				if (overflowed)
+				{
+					++m_stats.eventCount;
+					Record( directory.path, FileChange::Type::Overflow, now );
+				}
+				else if (succeeded)
+				{
+					ReadChanges( directory, size, now );
+				}
+				// any other failure means the directory went away, it isn't watched again
+				if (succeeded || overflowed)
+				{
+					Issue( directory );
+				}
+			}
+			next = Settle( now );
+#else
+			int timeout = -1;
+			if (next != Clock::time_point::max())
+			{
+				const auto wait = std::chrono::ceil<std::chrono::milliseconds>( next - Clock::now() ).count();
+				timeout = static_cast<int>(std::max<long long>( wait, 0 ));
+			}
+			pollfd fds[2] = { { m_inotify, POLLIN, 0 }, { m_wake, POLLIN, 0 } };
+			if (poll( fds, 2u, timeout ) < 0 && errno != EINTR)
+			{
+				return;
+			}
+			if (fds[1].revents != 0)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> lock( m_mutex );
+			const Clock::time_point now = Clock::now();
+			if (fds[0].revents & POLLIN)
+			{
+				ReadEvents( now );
+			}
+			next = Settle( now );
+#endif
+		}
+	}
+
+	void FileWatcher::Record( std::string path, FileChange::Type type, Clock::time_point now )
+	{
+		const auto [found, added] = m_pending.try_emplace( std::move( path ), Pending{ type, now } );
+		if (added)
+		{
+			return;
+		}
+		Pending& pending = found->second;
+		pending.last = now;
+		if (pending.type == FileChange::Type::Overflow)
+		{
+			return;
+		}
+		if (pending.type == FileChange::Type::Added)
+		{
+			if (type == FileChange::Type::Removed)
+			{
+				// a temporary file that came and went
+				m_pending.erase( found );
+			}
+			else if (type == FileChange::Type::Overflow)
+			{
+				pending.type = type;
+			}
+			return;
+		}
+		// saved by deleting and writing it again
+		const bool replaced = pending.type == FileChange::Type::Removed && type == FileChange::Type::Added;
+		pending.type = replaced ? FileChange::Type::Modified : type;
+	}
+
+	FileWatcher::Clock::time_point FileWatcher::Settle( Clock::time_point now )
+	{
+		Clock::time_point next = Clock::time_point::max();
+		std::vector<FileChange> settled;
+		for (auto it = m_pending.begin(); it != m_pending.end();)
+		{
+			const Clock::time_point due = it->second.last + m_debounce;
+			if (due > now)
+			{
+				next = std::min( next, due );
+				++it;
+				continue;
+			}
+			settled.push_back( { it->second.type, it->first } );
+			it = m_pending.erase( it );
+		}
+		if (!settled.empty())
+		{
+			m_stats.changeCount += settled.size();
+			std::lock_guard<std::mutex> lock( m_readyMutex );
+			std::move( settled.begin(), settled.end(), std::back_inserter( m_ready ) );
+		}
+		return next;
+	}
+
+#if defined(_WIN32)
+	bool FileWatcher::Issue( Directory& directory )
+	{
+		directory.overlapped = {};
+		return ReadDirectoryChangesW( directory.handle, directory.buffer, static_cast<DWORD>(sizeof( directory.buffer )),
+			directory.recursive ? TRUE : FALSE, notifyFilter, nullptr, &directory.overlapped, nullptr ) != FALSE;
+	}
+
+	void FileWatcher::ReadChanges( const Directory& directory, uint32_t size, Clock::time_point now )
+	{
+		std::string name;
+		for (uint32_t offset = 0u; offset < size;)
+		{
+			const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(directory.buffer + offset);
+			const int length = static_cast<int>(info->FileNameLength / sizeof( WCHAR ));
+			// same code page as the narrow paths handed to CreateFileA
+			name.resize( static_cast<size_t>(WideCharToMultiByte( CP_ACP, 0u, info->FileName, length, nullptr, 0, nullptr, nullptr )) );
+			WideCharToMultiByte( CP_ACP, 0u, info->FileName, length, name.data(), static_cast<int>(name.size()), nullptr, nullptr );
+			std::replace( name.begin(), name.end(), '\\', '/' );
+			FileChange::Type type = FileChange::Type::Modified;
+			switch (info->Action)
+			{
+			case FILE_ACTION_ADDED:
+			case FILE_ACTION_RENAMED_NEW_NAME:
+				type = FileChange::Type::Added;
+				break;
+			case FILE_ACTION_REMOVED:
+			case FILE_ACTION_RENAMED_OLD_NAME:
+				type = FileChange::Type::Removed;
+				break;
+			default:
+				break;
+			}
+			++m_stats.eventCount;
+			Record( Join( directory.path, name ), type, now );
+			if (info->NextEntryOffset == 0u)
+			{
+				break;
+			}
+			offset += info->NextEntryOffset;
+		}
+	}
+#else
+	FileWatcher::Directory* FileWatcher::AddDirectory( const std::string& path, bool recursive, bool reportFiles, Clock::time_point now )
+	{
+		const int watch = inotify_add_watch( m_inotify, path.c_str(), watchMask );
+		if (watch < 0)
+		{
+			return nullptr;
+		}
+		Directory*& directory = m_watches[watch];
+		if (!directory)
+		{
+			m_directories.push_back( std::make_unique<Directory>() );
+			directory = m_directories.back().get();
+			directory->path = path;
+			directory->watch = watch;
+			m_stats.directoryCount = m_directories.size();
+		}
+		directory->recursive = directory->recursive || recursive;
+		if (!recursive && !reportFiles)
+		{
+			return directory;
+		}
+		// the watch is in place before the listing, anything created meanwhile is seen twice at worst
+		std::error_code error;
+		for (std::filesystem::directory_iterator it( path, error ), end; !error && it != end; it.increment( error ))
+		{
+			std::error_code typeError;
+			// symlinks aren't followed, they could loop
+			if (it->is_symlink( typeError ))
+			{
+				continue;
+			}
+			const std::string child = Join( path, it->path().filename().string() );
+			if (it->is_directory( typeError ))
+			{
+				if (recursive)
+				{
+					AddDirectory( child, true, reportFiles, now );
+				}
+			}
+			else if (reportFiles)
+			{
+				Record( child, FileChange::Type::Added, now );
+			}
+		}
+		return directory;
+	}
+
+	void FileWatcher::RemoveDirectories( std::string path )
+	{
+		const auto below = [&path]( const std::string& other )
+		{
+			return other.size() > path.size() && other.compare( 0u, path.size(), path ) == 0 && other[path.size()] == '/';
+		};
+		for (auto it = m_directories.begin(); it != m_directories.end();)
+		{
+			Directory& directory = **it;
+			if (directory.path != path && !below( directory.path ))
+			{
+				++it;
+				continue;
+			}
+			inotify_rm_watch( m_inotify, directory.watch );
+			m_watches.erase( directory.watch );
+			it = m_directories.erase( it );
+		}
+		m_stats.directoryCount = m_directories.size();
+	}
+
+	void FileWatcher::ReadEvents( Clock::time_point now )
+	{
+		alignas(inotify_event) char buffer[64u * 1024u];
+		while (true)
+		{
+			const ssize_t size = read( m_inotify, buffer, sizeof( buffer ) );
+			if (size <= 0)
+			{
+				// EAGAIN once the queue is empty
+				return;
+			}
+			for (ssize_t offset = 0; offset < size;)
+			{
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+				offset += static_cast<ssize_t>(sizeof( inotify_event ) + event->len);
+				++m_stats.eventCount;
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					for (const auto& directory : m_directories)
+					{
+						if (directory->root)
+						{
+							Record( directory->path, FileChange::Type::Overflow, now );
+						}
+					}
+					continue;
+				}
+				const auto found = m_watches.find( event->wd );
+				if (found == m_watches.end())
+				{
+					continue;
+				}
+				Directory& directory = *found->second;
+				if (event->mask & IN_IGNORED)
+				{
+					// the directory was deleted
+					RemoveDirectories( directory.path );
+					continue;
+				}
+				if (event->len == 0u)
+				{
+					continue;
+				}
+				std::string path = Join( directory.path, event->name );
+				if (event->mask & IN_ISDIR)
+				{
+					if (event->mask & IN_MOVED_FROM)
+					{
+						// its watches would keep reporting under the old name
+						RemoveDirectories( path );
+					}
+					else if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && directory.recursive)
+					{
+						AddDirectory( path, true, true, now );
+					}
+					continue;
+				}
+				FileChange::Type type = FileChange::Type::Modified;
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					type = FileChange::Type::Added;
+				}
+				else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+				{
+					type = FileChange::Type::Removed;
+				}
+				Record( std::move( path ), type, now );
+			}
+		}
+	}
+#endif
+}
@@ -0,0 +1,118 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Exodus
+{
+	struct FileChange
+	{
+		enum class Type : uint8_t
+		{
+			Added,
+			Modified,
+			Removed,
+			// the OS dropped events, anything below path may have changed
+			Overflow,
+		};
+		Type type;
+		// watched directory joined with the relative name, lexically normalized with forward slashes
+		std::string path;
+	};
+
+	// Change notifications for directory trees without scanning them: inotify on Linux, one watch
+	// per directory, ReadDirectoryChangesW on Windows, one watch per tree. The OS events are read
+	// on a background thread and held per path until the file has been quiet for the debounce
+	// time, so a save that writes, truncates and renames shows up once. Drain() at a frame boundary.
+	//   watcher.Watch( "Content" );
+	//   watcher.Drain( changes ); // each frame
+	class FileWatcher
+	{
+	public:
+		struct Stats
+		{
+			size_t directoryCount = 0u;
+			uint64_t eventCount = 0u;
+			uint64_t changeCount = 0u;
+		};
+	private:
+		using Clock = std::chrono::steady_clock;
+		struct Pending
+		{
+			FileChange::Type type;
+			Clock::time_point last;
+		};
+		struct Directory;
+	public:
+		explicit FileWatcher( std::chrono::milliseconds debounce = std::chrono::milliseconds( 100 ) );
+		~FileWatcher();
+		FileWatcher( const FileWatcher& ) = delete;
+		FileWatcher& operator=( const FileWatcher& ) = delete;
+
+		// recursive also picks up directories created later, false if the directory can't be watched
+		bool Watch( const std::string& directory, bool recursive = true );
+		// appends the changes that settled since the last call
+		void Drain( std::vector<FileChange>& changes );
+		Stats GetStats() const;
+		void Stop();
+	private:
+		void Run();
+		// these hold m_mutex
+		void Record( std::string path, FileChange::Type type, Clock::time_point now );
+		// moves settled changes to m_ready, returns when the next one settles
+		Clock::time_point Settle( Clock::time_point now );
+#if defined(_WIN32)
+		bool Issue( Directory& directory );
+		void ReadChanges( const Directory& directory, uint32_t size, Clock::time_point now );
+#else
+		// reportFiles announces the files already inside a directory that appeared after the watch
+		Directory* AddDirectory( const std::string& path, bool recursive, bool reportFiles, Clock::time_point now );
+		// by value, the path usually belongs to one of the directories removed
+		void RemoveDirectories( std::string path );
+		void ReadEvents( Clock::time_point now );
+#endif
+	private:
+		const Clock::duration m_debounce;
+		// guards the directories, pending changes and stats, the ready list has its own lock
+		mutable std::mutex m_mutex;
+		std::vector<std::unique_ptr<Directory>> m_directories;
+		std::unordered_map<std::string, Pending> m_pending;
+		Stats m_stats;
+		std::mutex m_readyMutex;
+		std::vector<FileChange> m_ready;
+		std::thread m_thread;
+		bool m_running = false;
+#if defined(_WIN32)
+		void* m_port = nullptr;
+#else
+		int m_inotify = -1;
+		// written to wake the thread on Stop()
+		int m_wake = -1;
+		std::unordered_map<int, Directory*> m_watches;
+#endif
+	};
+}
@@ -0,0 +1,107 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "FixedTimestep.h"
+
+#include <cmath>
+
+namespace Exodus
+{
+	FixedTimestep::FixedTimestep( float tickRate, uint32_t maxStepsPerFrame, float maxFrameTime ) noexcept
+		:
+		m_step( 1.0f / 60.0f ),
+		m_maxSteps( maxStepsPerFrame > 0u ? maxStepsPerFrame : 1u ),
+		m_maxFrameTime( maxFrameTime )
+	{
+		SetTickRate( tickRate );
+	}
+
+	uint32_t FixedTimestep::Advance( float frameTime ) noexcept
+	{
+		if (frameTime > m_maxFrameTime)
+		{
+			m_droppedTime += frameTime - m_maxFrameTime;
+			frameTime = m_maxFrameTime;
+		}
+		m_accumulator += frameTime;
+
+		uint32_t steps = 0u;
+		while (m_accumulator >= m_step && steps < m_maxSteps)
+		{
+			m_accumulator -= m_step;
+			++steps;
+		}
+		// still behind after the last allowed step, drop whole steps and keep the fraction for alpha
+		if (m_accumulator >= m_step)
+		{
+			const double behind = m_accumulator - static_cast<double>(m_step) * static_cast<uint64_t>(m_accumulator / m_step);
+			m_droppedTime += m_accumulator - behind;
+			m_accumulator = behind;
+		}
+		return steps;
+	}
+
+	void FixedTimestep::Reset() noexcept
+	{
+		m_accumulator = 0.0;
+		m_droppedTime = 0.0;
+	}
+
+	bool FixedTimestep::SetTickRate( float tickRate ) noexcept
+	{
+		// 0 would make the step infinite and Advance() would never hand one out
+		if (!(tickRate > 0.0f) || !std::isfinite( tickRate ))
+		{
+			return false;
+		}
+		m_step = 1.0f / tickRate;
+		return true;
+	}
+
+	void FixedTimestep::SetMaxStepsPerFrame( uint32_t maxSteps ) noexcept
+	{
+		m_maxSteps = maxSteps > 0u ? maxSteps : 1u;
+	}
+
+	void FixedTimestep::SetMaxFrameTime( float maxFrameTime ) noexcept
+	{
+		m_maxFrameTime = maxFrameTime;
+	}
+
+	float FixedTimestep::GetStep() const noexcept
+	{
+		return m_step;
+	}
+
+	float FixedTimestep::GetTickRate() const noexcept
+	{
+		return 1.0f / m_step;
+	}
+
+	float FixedTimestep::GetAlpha() const noexcept
+	{
+		return static_cast<float>(m_accumulator / m_step);
+	}
+
+	double FixedTimestep::GetDroppedTime() const noexcept
+	{
+		return m_droppedTime;
+	}
+}
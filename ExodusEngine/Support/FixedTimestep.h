@@ -0,0 +1,53 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace Exodus
+{
+	// Accumulates frame time (from ExodusTimer::Mark) and hands out whole simulation steps of
+	// a fixed length. A long frame is clamped and the number of catch-up steps per frame is
+	// capped, so a hitch cannot snowball into ever longer frames. GetAlpha() is how far the
+	// leftover time reaches into the next step, for interpolating between simulation states.
+	class FixedTimestep
+	{
+	public:
+		// a tickRate that isn't positive falls back to 60
+		explicit FixedTimestep( float tickRate = 60.0f, uint32_t maxStepsPerFrame = 5u, float maxFrameTime = 0.25f ) noexcept;
+		// returns how many steps to simulate this frame
+		uint32_t Advance( float frameTime ) noexcept;
+		void Reset() noexcept;
+		// keeps the current rate and returns false unless tickRate is positive
+		bool SetTickRate( float tickRate ) noexcept;
+		void SetMaxStepsPerFrame( uint32_t maxSteps ) noexcept;
+		void SetMaxFrameTime( float maxFrameTime ) noexcept;
+		float GetStep() const noexcept;
+		float GetTickRate() const noexcept;
+		float GetAlpha() const noexcept;
+		// simulation time thrown away by the clamps since Reset()
+		double GetDroppedTime() const noexcept;
+	private:
+		float m_step;
+		uint32_t m_maxSteps;
+		float m_maxFrameTime;
+		double m_accumulator = 0.0;
+		double m_droppedTime = 0.0;
+	};
+}
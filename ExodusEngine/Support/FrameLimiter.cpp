@@ -0,0 +1,160 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "FrameLimiter.h"
+#include "ExodusTimer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+#include "WinInclude.h"
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace Exodus
+{
+	namespace
+	{
+		// spun on top of the expected overshoot, covers the jitter around it
+		constexpr uint64_t spinMargin = 200'000u;
+
+		uint64_t ToFrameTime( float rate ) noexcept
+		{
+			return rate > 0.0f ? static_cast<uint64_t>(1e9 / rate) : 0u;
+		}
+	}
+
+	FrameLimiter::FrameLimiter( float targetRate ) noexcept
+		:
+		m_frameTime( ToFrameTime( targetRate ) )
+	{
+#if defined(_WIN32)
+		// the default timer resolution is 15.6 ms, which would leave most of the frame to the spin
+		m_waitableTimer = CreateWaitableTimerExW( nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS );
+#endif
+	}
+
+	FrameLimiter::~FrameLimiter()
+	{
+#if defined(_WIN32)
+		if (m_waitableTimer)
+		{
+			CloseHandle( m_waitableTimer );
+		}
+#endif
+	}
+
+	void FrameLimiter::SetTargetRate( float rate ) noexcept
+	{
+		m_frameTime = ToFrameTime( rate );
+	}
+
+	void FrameLimiter::SetIdleRate( float rate, float idleDelay ) noexcept
+	{
+		m_idleFrameTime = ToFrameTime( rate );
+		m_idleDelay = static_cast<uint64_t>(std::max( idleDelay, 0.0f ) * 1e9);
+	}
+
+	float FrameLimiter::Wait( bool hadInput ) noexcept
+	{
+		const uint64_t start = ExodusTimer::Now();
+		if (hadInput || m_lastInput == 0u)
+		{
+			m_lastInput = start;
+		}
+		m_idle = m_idleFrameTime > 0u && start - m_lastInput >= m_idleDelay;
+		const uint64_t frameTime = m_idle ? std::max( m_idleFrameTime, m_frameTime ) : m_frameTime;
+		if (frameTime == 0u)
+		{
+			m_deadline = 0u;
+			return 0.0f;
+		}
+		uint64_t deadline = m_deadline + frameTime;
+		if (m_deadline == 0u || start > deadline + frameTime)
+		{
+			// first frame, or fell more than a frame behind: don't make up for it with a burst of short frames
+			deadline = start;
+		}
+
+		uint64_t now = start;
+		while (now < deadline)
+		{
+			const uint64_t margin = static_cast<uint64_t>(m_overshoot) + spinMargin;
+			if (deadline - now <= margin)
+			{
+				break;
+			}
+			const uint64_t request = deadline - now - margin;
+			Sleep( request );
+			const uint64_t woke = ExodusTimer::Now();
+			const double late = static_cast<double>(woke - now) - static_cast<double>(request);
+			// rise fast, decay slowly: waking up late costs more than spinning a little longer
+			m_overshoot += (late - m_overshoot) * (late > m_overshoot ? 0.5 : 0.02);
+			m_overshoot = std::max( m_overshoot, 0.0 );
+			now = woke;
+		}
+		while (now < deadline)
+		{
+			std::this_thread::yield();
+			now = ExodusTimer::Now();
+		}
+		m_deadline = deadline;
+		return static_cast<float>(static_cast<double>(now - start) * 1e-9);
+	}
+
+	void FrameLimiter::Reset() noexcept
+	{
+		m_deadline = 0u;
+		m_lastInput = 0u;
+		m_idle = false;
+	}
+
+	bool FrameLimiter::IsIdle() const noexcept
+	{
+		return m_idle;
+	}
+
+	float FrameLimiter::GetSleepOvershoot() const noexcept
+	{
+		return static_cast<float>(m_overshoot * 1e-9);
+	}
+
+	void FrameLimiter::Sleep( uint64_t duration ) noexcept
+	{
+#if defined(_WIN32)
+		if (m_waitableTimer)
+		{
+			// relative due time in 100 ns units
+			LARGE_INTEGER due = {};
+			due.QuadPart = -static_cast<LONGLONG>(duration / 100u);
+			if (SetWaitableTimer( m_waitableTimer, &due, 0, nullptr, nullptr, FALSE ))
+			{
+				WaitForSingleObject( m_waitableTimer, INFINITE );
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_for( std::chrono::nanoseconds( duration ) );
+	}
+}
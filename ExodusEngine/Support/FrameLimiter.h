@@ -0,0 +1,65 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace Exodus
+{
+	// Paces frames to a target rate without burning a core. A coarse OS sleep covers most of
+	// the remaining time and a short spin tail hits the deadline. The spin starts early by the
+	// sleep overshoot measured so far, which rises quickly after a late wake-up and decays
+	// slowly, so the limiter adapts to the scheduler it runs on. Deadlines advance by whole
+	// frame times, so a late frame is made up by the next one unless it fell more than a frame
+	// behind. With an idle rate set, frames run at that rate once no input arrived for a while.
+	// Times come from ExodusTimer::Now().
+	class FrameLimiter
+	{
+	public:
+		explicit FrameLimiter( float targetRate = 0.0f ) noexcept;
+		~FrameLimiter();
+		FrameLimiter( const FrameLimiter& ) = delete;
+		FrameLimiter& operator=( const FrameLimiter& ) = delete;
+		// frames per second, 0 doesn't limit
+		void SetTargetRate( float rate ) noexcept;
+		// rate after idleDelay seconds without input, 0 turns idle mode off
+		void SetIdleRate( float rate, float idleDelay = 1.0f ) noexcept;
+		// call once at the end of every frame, returns the seconds waited
+		float Wait( bool hadInput ) noexcept;
+		// forgets the previous deadline, the next Wait() returns straight away
+		void Reset() noexcept;
+		bool IsIdle() const noexcept;
+		// seconds the OS is currently expected to oversleep
+		float GetSleepOvershoot() const noexcept;
+	private:
+		void Sleep( uint64_t duration ) noexcept;
+	private:
+		// nanoseconds
+		uint64_t m_frameTime = 0u;
+		uint64_t m_idleFrameTime = 0u;
+		uint64_t m_idleDelay = 0u;
+		// 0 before the first frame
+		uint64_t m_deadline = 0u;
+		uint64_t m_lastInput = 0u;
+		double m_overshoot = 500'000.0;
+		bool m_idle = false;
+		// high resolution waitable timer on Windows, nullptr where it isn't available
+		void* m_waitableTimer = nullptr;
+	};
+}
@@ -0,0 +1,239 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Lz4.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Exodus
+{
+	namespace
+	{
+		constexpr size_t minMatch = 4u;
+		// the format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+		constexpr size_t lastLiterals = 5u;
+		constexpr size_t matchLimit = 12u;
+		constexpr size_t maxOffset = 65535u;
+		constexpr uint32_t hashBits = 16u;
+
+		uint32_t Read32( const std::byte* p ) noexcept
+		{
+			uint32_t value;
+			std::memcpy( &value, p, sizeof( value ) );
+			return value;
+		}
+
+		uint32_t Hash( uint32_t sequence ) noexcept
+		{
+			return (sequence * 2654435761u) >> (32u - hashBits);
+		}
+
+		// 15 in the token, then 255s and the remainder
+		bool WriteLength( std::byte*& out, const std::byte* end, size_t length ) noexcept
+		{
+			for (; length >= 255u; length -= 255u)
+			{
+				if (out == end)
+				{
+					return false;
+				}
+				*out++ = std::byte( 255u );
+			}
+			if (out == end)
+			{
+				return false;
+			}
+			*out++ = std::byte( length );
+			return true;
+		}
+
+		bool ReadLength( const std::byte*& in, const std::byte* end, size_t& length ) noexcept
+		{
+			uint8_t next;
+			do
+			{
+				if (in == end)
+				{
+					return false;
+				}
+				next = static_cast<uint8_t>(*in++);
+				length += next;
+			}
+			while (next == 255u);
+			return true;
+		}
+
+		bool WriteSequence( std::byte*& out, const std::byte* end, const std::byte* literals, size_t literalCount, size_t offset, size_t matchLength ) noexcept
+		{
+			if (out == end)
+			{
+				return false;
+			}
+			std::byte* token = out++;
+			uint8_t value = static_cast<uint8_t>((literalCount < 15u ? literalCount : 15u) << 4u);
+			if (literalCount >= 15u && !WriteLength( out, end, literalCount - 15u ))
+			{
+				return false;
+			}
+			if (static_cast<size_t>(end - out) < literalCount)
+			{
+				return false;
+			}
+			// literals can be null for an empty input
+			if (literalCount != 0u)
+			{
+				std::memcpy( out, literals, literalCount );
+				out += literalCount;
+			}
+			if (matchLength != 0u)
+			{
+				if (end - out < 2)
+				{
+					return false;
+				}
+				*out++ = std::byte( offset & 0xFFu );
+				*out++ = std::byte( offset >> 8u );
+				const size_t extra = matchLength - minMatch;
+				value |= static_cast<uint8_t>(extra < 15u ? extra : 15u);
+				if (extra >= 15u && !WriteLength( out, end, extra - 15u ))
+				{
+					return false;
+				}
+			}
+			*token = std::byte( value );
+			return true;
+		}
+	}
+
+	size_t Lz4::GetMaxCompressedSize( size_t size ) noexcept
+	{
+		return size + size / 255u + 16u;
+	}
+
+	size_t Lz4::Compress( const std::byte* source, size_t size, std::byte* destination, size_t capacity )
+	{
+		std::byte* out = destination;
+		const std::byte* const outEnd = destination + capacity;
+		size_t anchor = 0u;
+		if (size > matchLimit)
+		{
+			// positions + 1, 0 marks an empty bucket
+			std::vector<uint32_t> table( size_t( 1u ) << hashBits, 0u );
+			const size_t limit = size - matchLimit;
+			size_t pos = 0u;
+			while (pos < limit)
+			{
+				const uint32_t sequence = Read32( source + pos );
+				uint32_t& bucket = table[Hash( sequence )];
+				const size_t candidate = bucket;
+				bucket = static_cast<uint32_t>(pos + 1u);
+				if (candidate == 0u || pos + 1u - candidate > maxOffset || Read32( source + candidate - 1u ) != sequence)
+				{
+					// skip ahead faster the longer nothing matched
+					pos += 1u + ((pos - anchor) >> 6u);
+					continue;
+				}
+				const size_t match = candidate - 1u;
+				size_t length = minMatch;
+				while (pos + length < size - lastLiterals && source[match + length] == source[pos + length])
+				{
+					++length;
+				}
+				if (!WriteSequence( out, outEnd, source + anchor, pos - anchor, pos - match, length ))
+				{
+					return 0u;
+				}
+				pos += length;
+				anchor = pos;
+			}
+		}
+		if (!WriteSequence( out, outEnd, source + anchor, size - anchor, 0u, 0u ))
+		{
+			return 0u;
+		}
+		return static_cast<size_t>(out - destination);
+	}
+
+	bool Lz4::Decompress( const std::byte* source, size_t size, std::byte* destination, size_t originalSize ) noexcept
+	{
+		const std::byte* in = source;
+		const std::byte* const inEnd = source + size;
+		std::byte* out = destination;
+		std::byte* const outEnd = destination + originalSize;
+		while (in < inEnd)
+		{
+			const uint8_t token = static_cast<uint8_t>(*in++);
+			size_t literalCount = token >> 4u;
+			if (literalCount == 15u && !ReadLength( in, inEnd, literalCount ))
+			{
+				return false;
+			}
+			if (static_cast<size_t>(inEnd - in) < literalCount || static_cast<size_t>(outEnd - out) < literalCount)
+			{
+				return false;
+			}
+			// out can be null when the output is empty
+			if (literalCount != 0u)
+			{
+				std::memcpy( out, in, literalCount );
+				in += literalCount;
+				out += literalCount;
+			}
+			// the last sequence has no match
+			if (in == inEnd)
+			{
+				break;
+			}
+			if (inEnd - in < 2)
+			{
+				return false;
+			}
+			const size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8u);
+			in += 2;
+			size_t length = token & 15u;
+			if (length == 15u && !ReadLength( in, inEnd, length ))
+			{
+				return false;
+			}
+			length += minMatch;
+			if (offset == 0u || offset > static_cast<size_t>(out - destination) || static_cast<size_t>(outEnd - out) < length)
+			{
+				return false;
+			}
+			const std::byte* match = out - offset;
+			if (offset >= length)
+			{
+				std::memcpy( out, match, length );
+				out += length;
+			}
+			else
+			{
+				// overlapping copy repeats the last offset bytes
+				for (size_t i = 0u; i < length; ++i)
+				{
+					*out++ = *match++;
+				}
+			}
+		}
+		return out == outEnd;
+	}
+}
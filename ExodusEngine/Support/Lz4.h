@@ -0,0 +1,36 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+
+namespace Exodus
+{
+	// LZ4 block format (no frame), byte compatible with the reference implementation so
+	// archives can be produced or checked with stock lz4 tooling. Greedy single-probe matcher:
+	// fast enough for a packer, decompression is the part that matters at runtime.
+	namespace Lz4
+	{
+		size_t GetMaxCompressedSize( size_t size ) noexcept;
+		// 0 if the result would not fit in capacity
+		size_t Compress( const std::byte* source, size_t size, std::byte* destination, size_t capacity );
+		// false on malformed input or when the output isn't exactly originalSize bytes
+		bool Decompress( const std::byte* source, size_t size, std::byte* destination, size_t originalSize ) noexcept;
+	}
+}
@@ -0,0 +1,160 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include "WinInclude.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Exodus
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile( MappedFile&& other ) noexcept
+	{
+		*this = std::move( other );
+	}
+
+	MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_data = std::exchange( other.m_data, nullptr );
+			m_size = std::exchange( other.m_size, 0u );
+#if defined(_WIN32)
+			m_file = std::exchange( other.m_file, nullptr );
+			m_mapping = std::exchange( other.m_mapping, nullptr );
+#endif
+		}
+		return *this;
+	}
+
+	bool MappedFile::Open( const std::string& path )
+	{
+		Close();
+#if defined(_WIN32)
+		HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx( file, &size ) || size.QuadPart == 0)
+		{
+			CloseHandle( file );
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0u, 0u, nullptr );
+		if (!mapping)
+		{
+			CloseHandle( file );
+			return false;
+		}
+		void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0u, 0u, 0u );
+		if (!view)
+		{
+			CloseHandle( mapping );
+			CloseHandle( file );
+			return false;
+		}
+		m_file = file;
+		m_mapping = mapping;
+		m_data = static_cast<const std::byte*>(view);
+		m_size = static_cast<size_t>(size.QuadPart);
+#else
+		const int fd = open( path.c_str(), O_RDONLY );
+		if (fd < 0)
+		{
+			return false;
+		}
+		struct stat info;
+		if (fstat( fd, &info ) != 0 || info.st_size == 0)
+		{
+			close( fd );
+			return false;
+		}
+		void* view = mmap( nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0 );
+		// the mapping keeps its own reference to the file
+		close( fd );
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+		madvise( view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL );
+		m_data = static_cast<const std::byte*>(view);
+		m_size = static_cast<size_t>(info.st_size);
+#endif
+		return true;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+#if defined(_WIN32)
+		if (m_data)
+		{
+			UnmapViewOfFile( m_data );
+		}
+		if (m_mapping)
+		{
+			CloseHandle( m_mapping );
+		}
+		if (m_file)
+		{
+			CloseHandle( m_file );
+		}
+		m_mapping = nullptr;
+		m_file = nullptr;
+#else
+		if (m_data)
+		{
+			munmap( const_cast<std::byte*>(m_data), m_size );
+		}
+#endif
+		m_data = nullptr;
+		m_size = 0u;
+	}
+
+	bool MappedFile::IsOpen() const noexcept
+	{
+		return m_data != nullptr;
+	}
+
+	const std::byte* MappedFile::GetData() const noexcept
+	{
+		return m_data;
+	}
+
+	size_t MappedFile::GetSize() const noexcept
+	{
+		return m_size;
+	}
+}
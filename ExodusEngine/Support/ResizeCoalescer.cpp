@@ -0,0 +1,102 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ResizeCoalescer.h"
+
+namespace Exodus
+{
+	ResizeCoalescer::ResizeCoalescer( uint64_t minInterval ) noexcept
+		:
+		m_minInterval( minInterval )
+	{
+	}
+
+	void ResizeCoalescer::Reset( uint32_t width, uint32_t height ) noexcept
+	{
+		m_current = { width, height };
+		m_hasPending = false;
+	}
+
+	void ResizeCoalescer::Request( uint32_t width, uint32_t height ) noexcept
+	{
+		++m_stats.requests;
+		if (width == 0u || height == 0u)
+		{
+			return;
+		}
+		m_pending = { width, height };
+		m_hasPending = true;
+	}
+
+	bool ResizeCoalescer::Poll( uint64_t now, Size& size ) noexcept
+	{
+		if (!m_hasPending)
+		{
+			return false;
+		}
+		if (m_pending.width == m_current.width && m_pending.height == m_current.height)
+		{
+			// dragged back to where it started
+			m_hasPending = false;
+			return false;
+		}
+		if (m_hasApplied && now - m_lastApplied < m_minInterval)
+		{
+			return false;
+		}
+		m_current = m_pending;
+		m_hasPending = false;
+		m_hasApplied = true;
+		m_lastApplied = now;
+		++m_stats.applied;
+		size = m_current;
+		return true;
+	}
+
+	void ResizeCoalescer::Retry() noexcept
+	{
+		if (!m_hasApplied)
+		{
+			return;
+		}
+		if (!m_hasPending)
+		{
+			m_pending = m_current;
+			m_hasPending = true;
+		}
+		m_current = {};
+		++m_stats.failed;
+	}
+
+	bool ResizeCoalescer::IsPending() const noexcept
+	{
+		return m_hasPending;
+	}
+
+	ResizeCoalescer::Size ResizeCoalescer::GetCurrent() const noexcept
+	{
+		return m_current;
+	}
+
+	ResizeCoalescer::Stats ResizeCoalescer::GetStats() const noexcept
+	{
+		return m_stats;
+	}
+}
@@ -0,0 +1,69 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace Exodus
+{
+	// Turns the stream of size changes a window produces while its edge is dragged into few
+	// swap chain resizes. Requests overwrite each other, the latest size wins, and Poll() hands
+	// one out at most once per frame and no sooner than minInterval after the previous one.
+	// A resize after a quiet period goes through straight away. Zero sizes (minimised) and
+	// requests for the size already applied are dropped. Times are ExodusTimer::Now() values.
+	class ResizeCoalescer
+	{
+	public:
+		struct Size
+		{
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+		};
+		struct Stats
+		{
+			uint64_t requests = 0u;
+			uint64_t applied = 0u;
+			// handed out by Poll() but couldn't be applied
+			uint64_t failed = 0u;
+		};
+
+		explicit ResizeCoalescer( uint64_t minInterval = 50'000'000ull ) noexcept;
+		// size the swap chain currently has, forgets what is pending
+		void Reset( uint32_t width, uint32_t height ) noexcept;
+		void Request( uint32_t width, uint32_t height ) noexcept;
+		// true when size should be applied now, call once per frame
+		bool Poll( uint64_t now, Size& size ) noexcept;
+		// the size from the last Poll() couldn't be applied: it is handed out again after
+		// minInterval unless a newer request replaced it. Until one succeeds there is no current
+		// size, so even a request for the size from before goes through.
+		void Retry() noexcept;
+		bool IsPending() const noexcept;
+		Size GetCurrent() const noexcept;
+		Stats GetStats() const noexcept;
+	private:
+		uint64_t m_minInterval;
+		Size m_current;
+		Size m_pending;
+		bool m_hasPending = false;
+		// m_lastApplied means nothing until the first resize
+		bool m_hasApplied = false;
+		uint64_t m_lastApplied = 0u;
+		Stats m_stats;
+	};
+}
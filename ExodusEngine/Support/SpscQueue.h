@@ -0,0 +1,99 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace Exodus
+{
+	// Fixed-capacity ring buffer for exactly one producer thread and one consumer thread.
+	// Never allocates; a push into a full queue is rejected and counted instead of
+	// silently evicting older entries.
+	template<typename T, size_t Capacity>
+	class SpscQueue
+	{
+		static_assert((Capacity & (Capacity - 1u)) == 0u, "SpscQueue capacity must be a power of two");
+		static_assert(std::is_trivially_copyable_v<T>, "SpscQueue stores trivially copyable types only");
+	public:
+		SpscQueue() = default;
+		SpscQueue( const SpscQueue& ) = delete;
+		SpscQueue& operator=( const SpscQueue& ) = delete;
+
+		// producer side
+		bool Push( const T& value ) noexcept
+		{
+			const size_t tail = m_tail.load( std::memory_order_relaxed );
+			if (tail - m_head.load( std::memory_order_acquire ) >= Capacity)
+			{
+				m_overflowCount.fetch_add( 1u, std::memory_order_relaxed );
+				return false;
+			}
+			new (&m_storage[(tail & (Capacity - 1u)) * sizeof( T )]) T( value );
+			m_tail.store( tail + 1u, std::memory_order_release );
+			return true;
+		}
+
+		// consumer side
+		std::optional<T> Pop() noexcept
+		{
+			const size_t head = m_head.load( std::memory_order_relaxed );
+			if (head == m_tail.load( std::memory_order_acquire ))
+			{
+				return {};
+			}
+			const T value = *std::launder( reinterpret_cast<const T*>(&m_storage[(head & (Capacity - 1u)) * sizeof( T )]) );
+			m_head.store( head + 1u, std::memory_order_release );
+			return value;
+		}
+		// consumer side, drops everything currently queued
+		void Clear() noexcept
+		{
+			m_head.store( m_tail.load( std::memory_order_acquire ), std::memory_order_release );
+		}
+
+		bool Empty() const noexcept
+		{
+			return m_head.load( std::memory_order_acquire ) == m_tail.load( std::memory_order_acquire );
+		}
+		size_t Size() const noexcept
+		{
+			return m_tail.load( std::memory_order_acquire ) - m_head.load( std::memory_order_acquire );
+		}
+		static constexpr size_t GetCapacity() noexcept
+		{
+			return Capacity;
+		}
+		// pushes rejected because the queue was full
+		uint64_t GetOverflowCount() const noexcept
+		{
+			return m_overflowCount.load( std::memory_order_relaxed );
+		}
+	private:
+		// head and tail live on separate cache lines so producer and consumer don't share one
+		alignas(64) std::atomic<size_t> m_head = 0u;
+		alignas(64) std::atomic<size_t> m_tail = 0u;
+		std::atomic<uint64_t> m_overflowCount = 0u;
+		alignas(alignof(T)) unsigned char m_storage[Capacity * sizeof( T )];
+	};
+}
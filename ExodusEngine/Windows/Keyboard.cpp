@@ -29,44 +29,32 @@ namespace Exodus
 
 	std::optional<Keyboard::Event> Keyboard::ReadKey() noexcept
 	{
-		if (keybuffer.size() > 0u)
-		{
-			Keyboard::Event e = keybuffer.front();
-			keybuffer.pop();
-			return e;
-		}
-		return {};
+		return keybuffer.Pop();
 	}
 
 	bool Keyboard::KeyIsEmpty() const noexcept
 	{
-		return keybuffer.empty();
+		return keybuffer.Empty();
 	}
 
 	std::optional<char> Keyboard::ReadChar() noexcept
 	{
-		if (charbuffer.size() > 0u)
-		{
-			unsigned char charcode = charbuffer.front();
-			charbuffer.pop();
-			return charcode;
-		}
-		return {};
+		return charbuffer.Pop();
 	}
 
 	bool Keyboard::CharIsEmpty() const noexcept
 	{
-		return charbuffer.empty();
+		return charbuffer.Empty();
 	}
 
 	void Keyboard::FlushKey() noexcept
 	{
-		keybuffer = std::queue<Event>();
+		keybuffer.Clear();
 	}
 
 	void Keyboard::FlushChar() noexcept
 	{
-		charbuffer = std::queue<char>();
+		charbuffer.Clear();
 	}
 
 	void Keyboard::Flush() noexcept
@@ -90,37 +78,43 @@ namespace Exodus
 		return autorepeatEnabled;
 	}
 
+	uint64_t Keyboard::GetDroppedKeyCount() const noexcept
+	{
+		return keybuffer.GetOverflowCount();
+	}
+
+	uint64_t Keyboard::GetDroppedCharCount() const noexcept
+	{
+		return charbuffer.GetOverflowCount();
+	}
+
 	void Keyboard::OnKeyPressed( unsigned char keycode ) noexcept
 	{
 		keystates[keycode] = true;
-		keybuffer.push( Keyboard::Event( Keyboard::Event::Type::Press, keycode ) );
-		TrimBuffer( keybuffer );
+		keybuffer.Push( Keyboard::Event( Keyboard::Event::Type::Press, keycode ) );
 	}
 
 	void Keyboard::OnKeyReleased( unsigned char keycode ) noexcept
 	{
 		keystates[keycode] = false;
-		keybuffer.push( Keyboard::Event( Keyboard::Event::Type::Release, keycode ) );
-		TrimBuffer( keybuffer );
+		keybuffer.Push( Keyboard::Event( Keyboard::Event::Type::Release, keycode ) );
 	}
 
 	void Keyboard::OnChar( char character ) noexcept
 	{
-		charbuffer.push( character );
-		TrimBuffer( charbuffer );
+		charbuffer.Push( character );
 	}
 
 	void Keyboard::ClearState() noexcept
 	{
-		keystates.reset();
-	}
-
-	template<typename T>
-	void Keyboard::TrimBuffer( std::queue<T>& buffer ) noexcept
-	{
-		while (buffer.size() > bufferSize)
+		// queue releases for held keys so event consumers don't see them stuck either
+		for (unsigned int i = 0u; i < nKeys; ++i)
 		{
-			buffer.pop();
+			if (keystates[i])
+			{
+				keybuffer.Push( Keyboard::Event( Keyboard::Event::Type::Release, static_cast<unsigned char>(i) ) );
+			}
 		}
+		keystates.reset();
 	}
 }
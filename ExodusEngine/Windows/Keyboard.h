@@ -21,6 +21,8 @@
 #include "exopch.h"
 
 #include <bitset>
+#include "Support/ExodusTimer.h"
+#include "Support/SpscQueue.h"
 
 namespace Exodus
 {
@@ -39,11 +41,13 @@ namespace Exodus
 		private:
 			Type type;
 			unsigned char code;
+			uint64_t timestamp;
 		public:
 			Event( Type type, unsigned char code ) noexcept
 				:
 				type( type ),
-				code( code )
+				code( code ),
+				timestamp( ExodusTimer::Now() )
 			{
 			}
 			bool IsPress() const noexcept
@@ -58,6 +62,11 @@ namespace Exodus
 			{
 				return code;
 			}
+			// ExodusTimer::Now() when the message arrived
+			uint64_t GetTimestamp() const noexcept
+			{
+				return timestamp;
+			}
 		};
 	public:
 		Keyboard() = default;
@@ -77,19 +86,21 @@ namespace Exodus
 		void EnableAutorepeat() noexcept;
 		void DisableAutorepeat() noexcept;
 		bool AutorepeatIsEnabled() const noexcept;
+		// events rejected because the game thread did not drain the buffers in time
+		uint64_t GetDroppedKeyCount() const noexcept;
+		uint64_t GetDroppedCharCount() const noexcept;
 	private:
 		void OnKeyPressed( unsigned char keycode ) noexcept;
 		void OnKeyReleased( unsigned char keycode ) noexcept;
 		void OnChar( char character ) noexcept;
 		void ClearState() noexcept;
-		template<typename T>
-		static void TrimBuffer( std::queue<T>& buffer ) noexcept;
 	private:
 		static constexpr unsigned int nKeys = 256u;
-		static constexpr unsigned int bufferSize = 16u;
+		// the message pump produces, the game thread consumes; sized for several slow frames of typing
+		static constexpr unsigned int bufferSize = 256u;
 		bool autorepeatEnabled = false;
 		std::bitset<nKeys> keystates;
-		std::queue<Event> keybuffer;
-		std::queue<char> charbuffer;
+		SpscQueue<Event, bufferSize> keybuffer;
+		SpscQueue<char, bufferSize> charbuffer;
 	};
 }
\ No newline at end of file
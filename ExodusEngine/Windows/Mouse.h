@@ -19,6 +19,8 @@
 ******************************************************************************************/
 #pragma once
 #include "Support/exopch.h"
+#include "Support/ExodusTimer.h"
+#include "Support/SpscQueue.h"
 
 namespace Exodus
 {
@@ -51,6 +53,7 @@ namespace Exodus
 			bool rightIsPressed;
 			int x;
 			int y;
+			uint64_t timestamp;
 		public:
 			Event( Type type, const Mouse& parent ) noexcept
 				:
@@ -58,7 +61,8 @@ namespace Exodus
 				leftIsPressed( parent.leftIsPressed ),
 				rightIsPressed( parent.rightIsPressed ),
 				x( parent.x ),
-				y( parent.y )
+				y( parent.y ),
+				timestamp( ExodusTimer::Now() )
 			{
 			}
 			Type GetType() const noexcept
@@ -85,6 +89,11 @@ namespace Exodus
 			{
 				return rightIsPressed;
 			}
+			// ExodusTimer::Now() when the message arrived
+			uint64_t GetTimestamp() const noexcept
+			{
+				return timestamp;
+			}
 		};
 	public:
 		Mouse() = default;
@@ -100,12 +109,15 @@ namespace Exodus
 		std::optional<Mouse::Event> Read() noexcept;
 		bool IsEmpty() const noexcept
 		{
-			return buffer.empty();
+			return buffer.Empty();
 		}
 		void Flush() noexcept;
 		void EnableRaw() noexcept;
 		void DisableRaw() noexcept;
 		bool RawEnabled() const noexcept;
+		// events rejected because the game thread did not drain the buffers in time
+		uint64_t GetDroppedEventCount() const noexcept;
+		uint64_t GetDroppedRawDeltaCount() const noexcept;
 	private:
 		void OnMouseMove( int x, int y ) noexcept;
 		void OnMouseLeave() noexcept;
@@ -117,11 +129,12 @@ namespace Exodus
 		void OnRightReleased( int x, int y ) noexcept;
 		void OnWheelUp( int x, int y ) noexcept;
 		void OnWheelDown( int x, int y ) noexcept;
-		void TrimBuffer() noexcept;
-		void TrimRawInputBuffer() noexcept;
 		void OnWheelDelta( int x, int y, int delta ) noexcept;
 	private:
-		static constexpr unsigned int bufferSize = 16u;
+		// the message pump produces, the game thread consumes
+		static constexpr unsigned int bufferSize = 1024u;
+		// an 8 kHz mouse delivers ~270 deltas in a 30 fps frame, leave room for a few slow frames
+		static constexpr unsigned int rawBufferSize = 4096u;
 		int x;
 		int y;
 		bool leftIsPressed = false;
@@ -129,7 +142,7 @@ namespace Exodus
 		bool isInWindow = false;
 		int wheelDeltaCarry = 0;
 		bool rawEnabled = false;
-		std::queue<Event> buffer;
-		std::queue<RawDelta> rawDeltaBuffer;
+		SpscQueue<Event, bufferSize> buffer;
+		SpscQueue<RawDelta, rawBufferSize> rawDeltaBuffer;
 	};
 }
@@ -21,6 +21,7 @@
 #include "Support/WinInclude.h"
 #include "Application/EngineApplication.h"
 #include "Support/ExodusException.h"
+#include "Profiling/TraceExporter.h"
 
 extern Exodus::EngineApplication* CreateEngineApp();
 
@@ -30,10 +31,24 @@ int CALLBACK WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdL
 	{
 		SetThreadDpiAwarenessContext( DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2 );
 		Exodus::EngineApplication* app = CreateEngineApp();
+		// --record <log> writes the session's input for headless replay
+		const std::string cmdLine = lpCmdLine;
+		const size_t record = cmdLine.find( "--record " );
+		if (record != std::string::npos)
+		{
+			const size_t start = cmdLine.find_first_not_of( ' ', record + 9u );
+			const std::string path = start == std::string::npos ? std::string() : cmdLine.substr( start, cmdLine.find( ' ', start ) - start );
+			if (!app->RecordInput( path ))
+			{
+				MessageBoxA( nullptr, path.c_str(), "Could not create input log", MB_OK | MB_ICONEXCLAMATION );
+			}
+		}
 		return app->Run();
 	}
 	catch (const Exodus::ExodusException& e)
 	{
+		// keep the last recorded frames around for whoever investigates the error
+		Exodus::TraceExporter::Get().DumpNow( "ExodusError.trace.json" );
 		MessageBoxA( nullptr, e.what(), e.GetType(), MB_OK | MB_ICONEXCLAMATION );
 	}
 	catch (const std::exception& e)
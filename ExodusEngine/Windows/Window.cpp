@@ -19,6 +19,10 @@
 ******************************************************************************************/
 #include "exopch.h"
 #include "Window.h"
+#include "Memory/MemoryTracker.h"
+
+#include <filesystem>
+#include <fstream>
 
 // imgui
 #include "imgui/imgui.h"
@@ -28,6 +32,19 @@
 
 namespace Exodus
 {
+	namespace
+	{
+		void* ImGuiAlloc( size_t size, void* )
+		{
+			return MemoryTracker::Get().Allocate( MemoryTag::ImGui, size );
+		}
+
+		void ImGuiFree( void* ptr, void* )
+		{
+			MemoryTracker::Get().Free( MemoryTag::ImGui, ptr );
+		}
+	}
+
 	Window* CreateCWindow( int width, int height, const char* name)
 	{
 		Window* wnd = new Window( width, height, name );
@@ -124,6 +141,8 @@ namespace Exodus
 
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
+		// count ImGui's heap under its own tag
+		ImGui::SetAllocatorFunctions( &ImGuiAlloc, &ImGuiFree );
 		ImGui::CreateContext();
 		ImGuiIO& io = ImGui::GetIO(); (void)io;
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
@@ -276,6 +295,37 @@ namespace Exodus
 		m_shouldResize = false;
 	}
 
+	std::string Window::GetImGuiLayoutPath() const
+	{
+		if (!m_IMGuiInit || !ImGui::GetIO().IniFilename)
+		{
+			return {};
+		}
+		return std::filesystem::path( ImGui::GetIO().IniFilename ).lexically_normal().generic_string();
+	}
+
+	void Window::ReloadImGuiLayout()
+	{
+		const std::string path = GetImGuiLayoutPath();
+		if (path.empty())
+		{
+			return;
+		}
+		std::ifstream file( path, std::ios::in | std::ios::binary );
+		if (!file)
+		{
+			return;
+		}
+		const std::string layout( (std::istreambuf_iterator<char>( file )), std::istreambuf_iterator<char>() );
+		size_t currentSize = 0u;
+		const char* current = ImGui::SaveIniSettingsToMemory( &currentSize );
+		if (layout == std::string_view( current, currentSize ))
+		{
+			return;
+		}
+		ImGui::LoadIniSettingsFromMemory( layout.data(), layout.size() );
+	}
+
 	LPCWSTR Window::ConvertToLPCWSTR( const char* charArray )
 	{
 		int size = MultiByteToWideChar( CP_ACP, 0, charArray, -1, NULL, 0 );
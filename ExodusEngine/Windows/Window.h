@@ -65,6 +65,10 @@ namespace Exodus
 		int32_t GetHeight();
 		bool ShouldResize();
 		void ResizeFinished();
+		// where ImGui keeps its layout, empty when it doesn't save one
+		std::string GetImGuiLayoutPath() const;
+		// applies the layout file when it differs from the current layout, so ImGui's own saves are skipped
+		void ReloadImGuiLayout();
 	private:
 		LPCWSTR ConvertToLPCWSTR( const char* charArray );
 		static LRESULT CALLBACK HandleMsgSetup( HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam ) noexcept;
@@ -0,0 +1,127 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "Assets/AssetArchive.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Packs a content directory into an archive the engine mounts with AssetManager::MountArchive().
+// Entries are named by their path relative to the content directory.
+//   ExodusPacker <content dir> <output archive> [--compress] [--store .ext ...] [--align bytes]
+// --compress stores entries LZ4 compressed where that saves space, --store keeps files with the
+// given extension uncompressed (already compressed formats), --align sets the blob alignment.
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cerr << "usage: ExodusPacker <content dir> <output archive> [--compress] [--store .ext ...] [--align bytes]" << std::endl;
+	}
+
+	std::string Lower( std::string text )
+	{
+		std::transform( text.begin(), text.end(), text.begin(), []( unsigned char c ) { return static_cast<char>(std::tolower( c )); } );
+		return text;
+	}
+}
+
+int main( int argc, char** argv )
+{
+	namespace fs = std::filesystem;
+	if (argc < 3)
+	{
+		PrintUsage();
+		return -1;
+	}
+	const fs::path contentDir = argv[1];
+	const std::string output = argv[2];
+	bool compress = false;
+	uint32_t alignment = 64u;
+	std::vector<std::string> storedExtensions;
+	for (int i = 3; i < argc; ++i)
+	{
+		if (std::strcmp( argv[i], "--compress" ) == 0)
+		{
+			compress = true;
+		}
+		else if (std::strcmp( argv[i], "--store" ) == 0 && i + 1 < argc)
+		{
+			storedExtensions.push_back( Lower( argv[++i] ) );
+		}
+		else if (std::strcmp( argv[i], "--align" ) == 0 && i + 1 < argc)
+		{
+			alignment = static_cast<uint32_t>(std::strtoul( argv[++i], nullptr, 10 ));
+		}
+		else
+		{
+			PrintUsage();
+			return -1;
+		}
+	}
+	if (alignment == 0u || (alignment & (alignment - 1u)) != 0u)
+	{
+		std::cerr << "Alignment must be a power of two" << std::endl;
+		return -1;
+	}
+
+	std::error_code error;
+	std::vector<fs::path> files;
+	for (fs::recursive_directory_iterator it( contentDir, error ), end; !error && it != end; it.increment( error ))
+	{
+		if (it->is_regular_file())
+		{
+			files.push_back( it->path() );
+		}
+	}
+	if (error)
+	{
+		std::cerr << "Could not read " << contentDir.string() << ": " << error.message() << std::endl;
+		return -1;
+	}
+	// sorted so the same content always produces the same archive
+	std::sort( files.begin(), files.end() );
+
+	Exodus::AssetArchiveWriter writer( alignment );
+	for (const fs::path& file : files)
+	{
+		const std::string name = file.lexically_relative( contentDir ).generic_string();
+		const std::string extension = Lower( file.extension().string() );
+		const bool store = std::find( storedExtensions.begin(), storedExtensions.end(), extension ) != storedExtensions.end();
+		if (!writer.AddFile( name, file.string(), compress && !store ))
+		{
+			std::cerr << "Could not add " << name << " (unreadable or duplicate path)" << std::endl;
+			return -1;
+		}
+	}
+	if (!writer.Write( output ))
+	{
+		std::cerr << "Could not write " << output << std::endl;
+		return -1;
+	}
+	const auto stats = writer.GetStats();
+	std::cout << "Packed " << stats.entryCount << " files (" << stats.compressedCount << " compressed), "
+		<< stats.size << " bytes stored as " << stats.storedSize << " into " << output << std::endl;
+	return 0;
+}
@@ -0,0 +1,197 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Assets/AssetArchive.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	const char* const archivePath = "AssetArchiveTest.pak";
+
+	// two paths with the same 64 bit FNV-1a hash, found with a lattice search
+	const char* const collisionA = "collide/gaa56qa-aa";
+	const char* const collisionB = "collide/_rn081528d";
+
+	std::vector<std::byte> MakeText( size_t size, int seed )
+	{
+		const std::string line = "asset " + std::to_string( seed ) + " repeats itself a lot, ";
+		std::vector<std::byte> data( size );
+		for (size_t i = 0u; i < size; ++i)
+		{
+			data[i] = std::byte( line[i % line.size()] );
+		}
+		return data;
+	}
+
+	std::vector<std::byte> MakeNoise( size_t size, uint32_t state )
+	{
+		std::vector<std::byte> data( size );
+		for (std::byte& value : data)
+		{
+			state = state * 1664525u + 1013904223u;
+			value = std::byte( state >> 24u );
+		}
+		return data;
+	}
+
+	bool SameBytes( const AssetData& data, const std::vector<std::byte>& expected )
+	{
+		return data.size() == expected.size() && std::equal( data.begin(), data.end(), expected.begin() );
+	}
+
+	void TestRoundTrip()
+	{
+		struct Source
+		{
+			std::string path;
+			std::vector<std::byte> data;
+			bool compress;
+		};
+		std::vector<Source> sources;
+		sources.push_back( { "Textures/Grass.dds", MakeText( 20000u, 1 ), true } );
+		sources.push_back( { "Textures/Noise.dds", MakeNoise( 5000u, 7u ), true } );
+		sources.push_back( { "Shaders/Basic.hlsl", MakeText( 3000u, 2 ), false } );
+		sources.push_back( { "Empty.txt", {}, true } );
+		sources.push_back( { collisionA, MakeText( 100u, 3 ), false } );
+		sources.push_back( { collisionB, MakeNoise( 100u, 3u ), false } );
+		// enough entries for a few dozen buckets
+		for (int i = 0; i < 60; ++i)
+		{
+			sources.push_back( { "Levels/Level" + std::to_string( i ) + ".bin", MakeText( 64u + static_cast<size_t>(i) * 37u, i ), i % 2 == 0 } );
+		}
+		EXODUS_CHECK( AssetArchive::HashPath( collisionA ) == AssetArchive::HashPath( collisionB ) );
+
+		AssetArchiveWriter writer( 256u );
+		for (const Source& source : sources)
+		{
+			EXODUS_CHECK( writer.Add( source.path, source.data, source.compress ) );
+		}
+		// duplicates are rejected, whatever the case or slashes
+		EXODUS_CHECK( !writer.Add( "textures\\GRASS.dds", {}, false ) );
+		EXODUS_CHECK( writer.Write( archivePath ) );
+		EXODUS_CHECK( writer.GetStats().entryCount == sources.size() );
+
+		AssetArchive archive;
+		EXODUS_CHECK( archive.Open( archivePath ) );
+		EXODUS_CHECK( archive.GetEntryCount() == sources.size() );
+		for (const Source& source : sources)
+		{
+			const uint32_t entry = archive.Find( source.path );
+			EXODUS_CHECK( entry != AssetArchive::invalidEntry );
+			if (entry == AssetArchive::invalidEntry)
+			{
+				continue;
+			}
+			EXODUS_CHECK( archive.GetPath( entry ) == AssetArchive::NormalizePath( source.path ) );
+			EXODUS_CHECK( archive.GetSize( entry ) == source.data.size() );
+			AssetData data;
+			EXODUS_CHECK( archive.Read( entry, data ) );
+			EXODUS_CHECK( SameBytes( data, source.data ) );
+			if (!archive.IsCompressed( entry ))
+			{
+				const std::span<const std::byte> stored = archive.GetStored( entry );
+				EXODUS_CHECK( stored.size() == source.data.size() && std::equal( stored.begin(), stored.end(), source.data.begin() ) );
+			}
+		}
+		// text shrinks, noise doesn't, and nothing is compressed that wasn't asked to be
+		EXODUS_CHECK( archive.IsCompressed( archive.Find( "Textures/Grass.dds" ) ) );
+		EXODUS_CHECK( !archive.IsCompressed( archive.Find( "Textures/Noise.dds" ) ) );
+		EXODUS_CHECK( !archive.IsCompressed( archive.Find( "Shaders/Basic.hlsl" ) ) );
+		EXODUS_CHECK( writer.GetStats().compressedCount > 0u );
+
+		// the colliding pair sits next to each other in the table, the path tells them apart
+		const uint32_t a = archive.Find( collisionA );
+		const uint32_t b = archive.Find( collisionB );
+		EXODUS_CHECK( a != b && (a + 1u == b || b + 1u == a) );
+
+		// every entry, including the first and last of each bucket, resolves to itself
+		for (uint32_t entry = 0u; entry < archive.GetEntryCount(); ++entry)
+		{
+			EXODUS_CHECK( archive.Find( archive.GetPath( entry ) ) == entry );
+		}
+
+		// lookups ignore case and slash direction
+		const uint32_t grass = archive.Find( "textures/grass.dds" );
+		EXODUS_CHECK( grass != AssetArchive::invalidEntry );
+		EXODUS_CHECK( archive.Find( "TEXTURES\\GRASS.DDS" ) == grass );
+		EXODUS_CHECK( archive.Find( "Textures\\Grass.dds" ) == grass );
+		EXODUS_CHECK( archive.Find( "Levels\\LEVEL59.bin" ) == archive.Find( "levels/level59.bin" ) );
+
+		EXODUS_CHECK( archive.Find( "Textures/Grass.dd" ) == AssetArchive::invalidEntry );
+		EXODUS_CHECK( archive.Find( "Textures/Grass.dds/" ) == AssetArchive::invalidEntry );
+		EXODUS_CHECK( archive.Find( "collide/gaa56qa-ab" ) == AssetArchive::invalidEntry );
+		EXODUS_CHECK( archive.Find( "" ) == AssetArchive::invalidEntry );
+		archive.Close();
+		EXODUS_CHECK( !archive.IsOpen() && archive.Find( "Textures/Grass.dds" ) == AssetArchive::invalidEntry );
+	}
+
+	void TestSmallArchives()
+	{
+		// no entries, then a single bucket
+		AssetArchiveWriter empty;
+		EXODUS_CHECK( empty.Write( archivePath ) );
+		AssetArchive archive;
+		EXODUS_CHECK( archive.Open( archivePath ) );
+		EXODUS_CHECK( archive.GetEntryCount() == 0u && archive.Find( "anything" ) == AssetArchive::invalidEntry );
+		archive.Close();
+
+		AssetArchiveWriter single;
+		const std::vector<std::byte> data = MakeText( 1000u, 9 );
+		EXODUS_CHECK( single.Add( "Only.txt", data, true ) );
+		EXODUS_CHECK( single.Write( archivePath ) );
+		EXODUS_CHECK( archive.Open( archivePath ) );
+		const uint32_t entry = archive.Find( "ONLY.TXT" );
+		EXODUS_CHECK( entry == 0u );
+		AssetData read;
+		EXODUS_CHECK( entry == 0u && archive.Read( entry, read ) && SameBytes( read, data ) );
+		EXODUS_CHECK( archive.Find( "Other.txt" ) == AssetArchive::invalidEntry );
+	}
+
+	void TestNotAnArchive()
+	{
+		std::FILE* file = std::fopen( archivePath, "wb" );
+		EXODUS_CHECK( file != nullptr );
+		if (file)
+		{
+			const std::vector<std::byte> noise = MakeNoise( 200u, 1u );
+			std::fwrite( noise.data(), 1u, noise.size(), file );
+			std::fclose( file );
+		}
+		AssetArchive archive;
+		EXODUS_CHECK( !archive.Open( archivePath ) );
+		EXODUS_CHECK( !archive.Open( "AssetArchiveTest.missing" ) );
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestSmallArchives();
+	TestNotAnArchive();
+	std::remove( archivePath );
+	return EXODUS_TEST_RESULT();
+}
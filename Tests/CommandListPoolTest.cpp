@@ -0,0 +1,216 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "D3D/CommandListPool.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	constexpr uint32_t invalid = CommandListPool::invalidIndex;
+
+	void TestLimits()
+	{
+		CommandListPool pool( 2u, 3u );
+		const CommandListPool::Acquired a = pool.Acquire( 0u, 0u );
+		const CommandListPool::Acquired b = pool.Acquire( 0u, 0u );
+		EXODUS_CHECK( a.list != invalid && b.list != invalid && a.list != b.list && a.allocator != b.allocator );
+		// out of lists
+		EXODUS_CHECK( pool.Acquire( 0u, 0u ).list == invalid );
+		EXODUS_CHECK( pool.GetOldestFenceValue() == 0u );
+		pool.Finish( a.list );
+		pool.Finish( b.list );
+		std::vector<CommandListPool::Submission> submissions;
+		pool.Submit( 1u, submissions );
+		EXODUS_CHECK( submissions.size() == 2u );
+		// lists are free again, the third allocator is still unused
+		const CommandListPool::Acquired c = pool.Acquire( 0u, 0u );
+		EXODUS_CHECK( c.list != invalid && c.allocator != a.allocator && c.allocator != b.allocator );
+		// the other two are in flight until fence 1 completes
+		EXODUS_CHECK( pool.Acquire( 0u, 0u ).list == invalid );
+		EXODUS_CHECK( pool.GetOldestFenceValue() == 1u );
+		const CommandListPool::Acquired d = pool.Acquire( 0u, 1u );
+		EXODUS_CHECK( d.list != invalid && (d.allocator == a.allocator || d.allocator == b.allocator) );
+		// fence 1 brought both back
+		EXODUS_CHECK( pool.GetStats().recording == 2u && pool.GetStats().allocatorsInFlight == 0u );
+	}
+
+	void TestOrderAndAbandon()
+	{
+		CommandListPool pool( 4u, 4u );
+		const CommandListPool::Acquired late = pool.Acquire( 20u, 0u );
+		const CommandListPool::Acquired first = pool.Acquire( 10u, 0u );
+		const CommandListPool::Acquired second = pool.Acquire( 10u, 0u );
+		const CommandListPool::Acquired dropped = pool.Acquire( 5u, 0u );
+		pool.Finish( late.list );
+		pool.Finish( second.list );
+		pool.Finish( first.list );
+		// never recorded, list and allocator come back without waiting for a fence
+		pool.Abandon( dropped.list );
+		EXODUS_CHECK( pool.GetStats().recording == 0u );
+		std::vector<CommandListPool::Submission> submissions;
+		pool.Submit( 1u, submissions );
+		EXODUS_CHECK( submissions.size() == 3u && submissions[0].list == first.list && submissions[1].list == second.list && submissions[2].list == late.list );
+		EXODUS_CHECK( pool.GetStats().allocatorsInFlight == 3u );
+		const CommandListPool::Acquired reused = pool.Acquire( 0u, 0u );
+		EXODUS_CHECK( reused.allocator == dropped.allocator );
+		// finished or abandoned twice has no effect
+		pool.Abandon( dropped.list );
+		pool.Finish( late.list );
+		EXODUS_CHECK( pool.GetStats().recording == 1u );
+	}
+
+	// Mock device: an allocator remembers the fence value of the submission that last used
+	// it, a thread on the side plays the GPU and completes fence values a little later.
+	struct MockAllocator
+	{
+		uint64_t lastFenceValue = 0u;
+		std::atomic<int> users = 0;
+	};
+	struct MockList
+	{
+		std::atomic<int> recording = 0;
+		uint32_t allocator = invalid;
+	};
+
+	// Up to eight workers per frame acquire, "record" and finish lists while the main thread
+	// submits. No allocator may be reset while the GPU could still read it, no list or
+	// allocator may be handed to two threads at once, and submissions come out in key order.
+	void TestWorkerStress()
+	{
+		constexpr uint32_t maxLists = 16u;
+		constexpr uint32_t maxAllocators = 9u;
+		constexpr int frames = 2000;
+		CommandListPool pool( maxLists, maxAllocators );
+		std::vector<MockAllocator> allocators( maxAllocators );
+		std::vector<MockList> lists( maxLists );
+		std::atomic<uint64_t> completed = 0u;
+		std::atomic<uint64_t> signalled = 0u;
+		std::atomic<int> errors = 0;
+		std::atomic<bool> stop = false;
+		std::thread gpu( [&]()
+		{
+			while (!stop)
+			{
+				const uint64_t value = completed.load();
+				if (value < signalled.load())
+				{
+					completed.store( value + 1u );
+				}
+				std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+			}
+		} );
+
+		std::vector<CommandListPool::Submission> submissions;
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			const int workers = 1 + frame % 8;
+			// one worker per odd frame gives its list back without recording
+			const int abandoning = frame % 2 ? frame % workers : -1;
+			std::vector<std::thread> threads;
+			for (int worker = 0; worker < workers; ++worker)
+			{
+				threads.emplace_back( [&, worker]()
+				{
+					CommandListPool::Acquired acquired = pool.Acquire( uint64_t( 7 - worker ), completed.load() );
+					while (acquired.list == invalid)
+					{
+						const uint64_t oldest = pool.GetOldestFenceValue();
+						if (oldest == 0u)
+						{
+							++errors;
+							return;
+						}
+						while (completed.load() < oldest)
+						{
+							std::this_thread::yield();
+						}
+						acquired = pool.Acquire( uint64_t( 7 - worker ), completed.load() );
+					}
+					MockAllocator& allocator = allocators[acquired.allocator];
+					MockList& list = lists[acquired.list];
+					if (allocator.lastFenceValue > completed.load())
+					{
+						++errors;
+					}
+					if (allocator.users.fetch_add( 1 ) != 0 || list.recording.fetch_add( 1 ) != 0)
+					{
+						++errors;
+					}
+					list.allocator = acquired.allocator;
+					std::this_thread::yield();
+					list.recording.fetch_sub( 1 );
+					allocator.users.fetch_sub( 1 );
+					if (worker == abandoning)
+					{
+						pool.Abandon( acquired.list );
+					}
+					else
+					{
+						pool.Finish( acquired.list );
+					}
+				} );
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			submissions.clear();
+			const uint64_t fenceValue = signalled.load() + 1u;
+			pool.Submit( fenceValue, submissions );
+			if (submissions.size() != static_cast<size_t>(workers - (abandoning >= 0 ? 1 : 0)))
+			{
+				++errors;
+			}
+			for (size_t i = 1u; i < submissions.size(); ++i)
+			{
+				if (submissions[i - 1u].sortKey > submissions[i].sortKey)
+				{
+					++errors;
+				}
+			}
+			for (const CommandListPool::Submission& submission : submissions)
+			{
+				allocators[lists[submission.list].allocator].lastFenceValue = fenceValue;
+			}
+			signalled.store( fenceValue );
+		}
+		stop = true;
+		gpu.join();
+		const CommandListPool::Stats stats = pool.GetStats();
+		EXODUS_CHECK( errors == 0 );
+		EXODUS_CHECK( stats.recording == 0u );
+		EXODUS_CHECK( stats.listsCreated <= maxLists && stats.allocatorsCreated <= maxAllocators );
+	}
+}
+
+int main()
+{
+	TestLimits();
+	TestOrderAndAbandon();
+	TestWorkerStress();
+	return EXODUS_TEST_RESULT();
+}
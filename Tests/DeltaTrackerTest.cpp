@@ -0,0 +1,138 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ECS/DeltaTracker.h"
+#include "TestCheck.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace Exodus;
+
+namespace
+{
+	struct Position
+	{
+		float x, y;
+
+		bool operator==( const Position& ) const = default;
+	};
+
+	void TestNothingRecordedBeforeTrack()
+	{
+		Registry registry;
+		DeltaTracker tracker( registry );
+		EXODUS_CHECK( !tracker.IsTracking() );
+		// without a tracked type the entity signals aren't even connected
+		for (int i = 0; i < 1000; ++i)
+		{
+			registry.destroy( registry.create() );
+		}
+		const entt::entity kept = registry.create();
+		registry.emplace<Position>( kept, 1.0f, 2.0f );
+		tracker.Track<Position>();
+		EXODUS_CHECK( tracker.IsTracking() );
+		EXODUS_CHECK( tracker.Commit().Empty() );
+	}
+
+	void TestCommitAndRevert()
+	{
+		Registry registry;
+		DeltaTracker tracker( registry );
+		tracker.Track<Position>();
+		const entt::entity moved = registry.create();
+		registry.emplace<Position>( moved, 0.0f, 0.0f );
+		const RegistryDelta created = tracker.Commit();
+		EXODUS_CHECK( created.created.size() == 1u && created.pools.size() == 1u );
+
+		registry.patch<Position>( moved, []( Position& position ) { position.x = 5.0f; } );
+		const entt::entity spawned = registry.create();
+		registry.emplace<Position>( spawned, 3.0f, 3.0f );
+		const RegistryDelta step = tracker.Commit();
+		EXODUS_CHECK( step.created.size() == 1u && step.pools.size() == 1u && step.pools[0]->entities.size() == 2u );
+		// committed, nothing left over
+		EXODUS_CHECK( tracker.Commit().Empty() );
+
+		tracker.Revert( step );
+		EXODUS_CHECK( !registry.valid( spawned ) );
+		EXODUS_CHECK( registry.get<Position>( moved ).x == 0.0f );
+		tracker.Apply( step );
+		EXODUS_CHECK( registry.valid( spawned ) && (registry.get<Position>( spawned ) == Position{ 3.0f, 3.0f }) );
+		EXODUS_CHECK( registry.get<Position>( moved ).x == 5.0f );
+		// applying is not a change of its own
+		EXODUS_CHECK( tracker.Commit().Empty() );
+	}
+
+	bool ReadDelta( const DeltaTracker& tracker, const std::string& bytes, RegistryDelta& delta )
+	{
+		SnapshotInput in( reinterpret_cast<const std::byte*>(bytes.data()), bytes.size() );
+		return tracker.Read( in, delta );
+	}
+
+	void TestCorruptFlags()
+	{
+		Registry registry;
+		DeltaTracker tracker( registry );
+		tracker.Track<Position>();
+		const entt::entity moved = registry.create();
+		registry.emplace<Position>( moved, 0.0f, 0.0f );
+		tracker.Commit();
+		registry.patch<Position>( moved, []( Position& position ) { position.x = 5.0f; } );
+		registry.emplace<Position>( registry.create(), 3.0f, 3.0f );
+		const RegistryDelta step = tracker.Commit();
+		std::ostringstream stream;
+		{
+			SnapshotOutput out( stream );
+			tracker.Write( step, out );
+			out.Flush();
+		}
+		const std::string original = stream.str();
+		RegistryDelta delta;
+		EXODUS_CHECK( ReadDelta( tracker, original, delta ) );
+		EXODUS_CHECK( delta.pools.size() == 1u && delta.pools[0]->flags == step.pools[0]->flags );
+
+		// the pool ends with its two flags, the before/after counts and one before, two after values
+		EXODUS_CHECK( step.pools[0]->flags.size() == 2u );
+		const size_t flags = original.size() - 3u * sizeof( Position ) - 2u * sizeof( uint32_t ) - 2u;
+		EXODUS_CHECK( original.compare( flags, 2u, reinterpret_cast<const char*>(step.pools[0]->flags.data()), 2u ) == 0 );
+		// a before nobody wrote, an after missing, a bit that isn't a flag
+		const uint8_t corruptions[][2] = {
+			{ PoolDelta::HasBefore | PoolDelta::HasAfter, PoolDelta::HasBefore | PoolDelta::HasAfter },
+			{ PoolDelta::HasBefore | PoolDelta::HasAfter, 0u },
+			{ PoolDelta::HasBefore | PoolDelta::HasAfter | 4u, PoolDelta::HasAfter },
+			{ 0x80u, PoolDelta::HasAfter },
+		};
+		for (const auto& corruption : corruptions)
+		{
+			std::string corrupt = original;
+			std::memcpy( corrupt.data() + flags, corruption, sizeof( corruption ) );
+			EXODUS_CHECK( !ReadDelta( tracker, corrupt, delta ) );
+		}
+	}
+}
+
+int main()
+{
+	TestNothingRecordedBeforeTrack();
+	TestCommitAndRevert();
+	TestCorruptFlags();
+	return EXODUS_TEST_RESULT();
+}
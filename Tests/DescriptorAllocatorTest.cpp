@@ -0,0 +1,174 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "D3D/DescriptorAllocator.h"
+#include "TestCheck.h"
+
+#include <deque>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	constexpr uint32_t invalid = DescriptorAllocator::invalidIndex;
+
+	void TestPersistent()
+	{
+		DescriptorAllocator allocator( 4u, 0u );
+		std::set<uint32_t> indices;
+		for (int i = 0; i < 4; ++i)
+		{
+			indices.insert( allocator.AllocatePersistent() );
+		}
+		EXODUS_CHECK( indices == std::set<uint32_t>( { 0u, 1u, 2u, 3u } ) );
+		EXODUS_CHECK( allocator.AllocatePersistent() == invalid );
+
+		// a freed index waits for the submission after the free to complete
+		allocator.FreePersistent( 2u );
+		allocator.Reclaim( 100u );
+		EXODUS_CHECK( allocator.AllocatePersistent() == invalid );
+		allocator.MarkSubmitted( 5u );
+		allocator.Reclaim( 4u );
+		EXODUS_CHECK( allocator.AllocatePersistent() == invalid );
+		allocator.Reclaim( 5u );
+		EXODUS_CHECK( allocator.AllocatePersistent() == 2u );
+		EXODUS_CHECK( allocator.GetStats().persistentUsed == 4u );
+		// never handed out, ignored
+		DescriptorAllocator fresh( 4u, 0u );
+		fresh.FreePersistent( 3u );
+		fresh.MarkSubmitted( 1u );
+		fresh.Reclaim( 1u );
+		EXODUS_CHECK( fresh.GetStats().persistentUsed == 0u );
+	}
+
+	void TestTransient()
+	{
+		DescriptorAllocator allocator( 16u, 64u );
+		const uint32_t first = allocator.AllocateTransient( 40u );
+		EXODUS_CHECK( first == 16u );
+		allocator.MarkSubmitted( 1u );
+		// doesn't fit behind the first range and can't wrap onto it while it's in flight
+		EXODUS_CHECK( allocator.AllocateTransient( 30u ) == invalid );
+		EXODUS_CHECK( allocator.GetOldestFenceValue() == 1u );
+		const uint32_t second = allocator.AllocateTransient( 20u );
+		EXODUS_CHECK( second == 56u );
+		allocator.MarkSubmitted( 2u );
+		allocator.Reclaim( 1u );
+		// wraps to the start of the transient region once frame 1 is done
+		const uint32_t third = allocator.AllocateTransient( 30u );
+		EXODUS_CHECK( third == 16u );
+		allocator.MarkSubmitted( 3u );
+		allocator.Reclaim( 3u );
+		EXODUS_CHECK( allocator.GetOldestFenceValue() == 0u );
+		EXODUS_CHECK( allocator.GetStats().transientUsed == 0u );
+	}
+
+	struct Range
+	{
+		uint64_t fenceValue;
+		uint32_t first;
+		uint32_t count;
+	};
+
+	// three frames in flight with random traffic, no live index may be handed out twice
+	void TestFramesInFlight()
+	{
+		constexpr uint32_t persistentCount = 1024u;
+		constexpr uint32_t transientCount = 4096u;
+		DescriptorAllocator allocator( persistentCount, transientCount );
+		std::mt19937 random( 7u );
+		std::vector<uint32_t> persistent;
+		// held until the frame that freed them completed
+		std::set<uint32_t> persistentSet;
+		std::deque<Range> freed;
+		std::deque<Range> ranges;
+		std::vector<uint8_t> transientOwner( transientCount, 0u );
+		bool valid = true;
+		uint64_t fence = 0u;
+		for (int frame = 0; frame < 2000; ++frame)
+		{
+			const uint64_t completed = fence > 2u ? fence - 2u : 0u;
+			allocator.Reclaim( completed );
+			while (!ranges.empty() && ranges.front().fenceValue <= completed)
+			{
+				for (uint32_t i = 0u; i < ranges.front().count; ++i)
+				{
+					transientOwner[ranges.front().first - persistentCount + i] = 0u;
+				}
+				ranges.pop_front();
+			}
+			while (!freed.empty() && freed.front().fenceValue <= completed)
+			{
+				persistentSet.erase( freed.front().first );
+				freed.pop_front();
+			}
+			for (int i = 0; i < 64; ++i)
+			{
+				const uint32_t count = 1u + random() % 32u;
+				const uint32_t first = allocator.AllocateTransient( count );
+				if (first == invalid)
+				{
+					continue;
+				}
+				valid &= first >= persistentCount && first + count <= persistentCount + transientCount;
+				for (uint32_t j = 0u; j < count && valid; ++j)
+				{
+					valid &= transientOwner[first - persistentCount + j] == 0u;
+					transientOwner[first - persistentCount + j] = 1u;
+				}
+				ranges.push_back( { fence + 1u, first, count } );
+			}
+			for (int i = 0; i < 32; ++i)
+			{
+				if (!persistent.empty() && random() % 2u)
+				{
+					const size_t slot = random() % persistent.size();
+					allocator.FreePersistent( persistent[slot] );
+					freed.push_back( { fence + 1u, persistent[slot], 1u } );
+					persistent[slot] = persistent.back();
+					persistent.pop_back();
+				}
+				else
+				{
+					const uint32_t index = allocator.AllocatePersistent();
+					if (index != invalid)
+					{
+						valid &= index < persistentCount && persistentSet.insert( index ).second;
+						persistent.push_back( index );
+					}
+				}
+			}
+			allocator.MarkSubmitted( ++fence );
+		}
+		EXODUS_CHECK( valid );
+		EXODUS_CHECK( allocator.GetStats().persistentUsed >= persistent.size() );
+	}
+}
+
+int main()
+{
+	TestPersistent();
+	TestTransient();
+	TestFramesInFlight();
+	return EXODUS_TEST_RESULT();
+}
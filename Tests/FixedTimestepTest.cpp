@@ -0,0 +1,79 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Support/FixedTimestep.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace Exodus;
+
+namespace
+{
+	bool Near( double a, double b )
+	{
+		return std::fabs( a - b ) < 1e-4;
+	}
+
+	void TestInvalidRates()
+	{
+		FixedTimestep step( 30.0f );
+		EXODUS_CHECK( !step.SetTickRate( 0.0f ) );
+		EXODUS_CHECK( !step.SetTickRate( -10.0f ) );
+		EXODUS_CHECK( !step.SetTickRate( std::numeric_limits<float>::quiet_NaN() ) );
+		EXODUS_CHECK( !step.SetTickRate( std::numeric_limits<float>::infinity() ) );
+		EXODUS_CHECK( Near( step.GetTickRate(), 30.0 ) );
+		EXODUS_CHECK( step.Advance( 0.11f ) == 3u );
+		EXODUS_CHECK( Near( FixedTimestep( 0.0f ).GetTickRate(), 60.0 ) );
+	}
+
+	void TestStepsAndAlpha()
+	{
+		FixedTimestep step( 100.0f );
+		EXODUS_CHECK( step.Advance( 0.005f ) == 0u );
+		EXODUS_CHECK( Near( step.GetAlpha(), 0.5 ) );
+		EXODUS_CHECK( step.Advance( 0.0075f ) == 1u );
+		EXODUS_CHECK( Near( step.GetAlpha(), 0.25 ) );
+		uint32_t steps = 0u;
+		for (int i = 0; i < 1000; ++i)
+		{
+			steps += step.Advance( 0.01f );
+		}
+		EXODUS_CHECK( steps == 1000u || steps == 999u );
+	}
+
+	void TestClamps()
+	{
+		FixedTimestep step( 100.0f, 5u, 0.25f );
+		// a hitch is clamped to 0.25 s, of which 5 steps run and the rest is dropped
+		EXODUS_CHECK( step.Advance( 1.0f ) == 5u );
+		EXODUS_CHECK( step.GetAlpha() < 1.0f );
+		EXODUS_CHECK( Near( step.GetDroppedTime(), 0.95 ) );
+	}
+}
+
+int main()
+{
+	TestInvalidRates();
+	TestStepsAndAlpha();
+	TestClamps();
+	return EXODUS_TEST_RESULT();
+}
@@ -0,0 +1,160 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "D3D/FrameRing.h"
+#include "TestCheck.h"
+
+#include <deque>
+
+using namespace Exodus;
+
+namespace
+{
+	// Stands in for a command queue and its fence: submissions complete in order, one per
+	// Step(), so the GPU lags behind the CPU by however many frames are queued.
+	class MockQueue
+	{
+	public:
+		uint64_t Signal()
+		{
+			m_queued.push_back( ++m_signalled );
+			return m_signalled;
+		}
+		void Step()
+		{
+			if (!m_queued.empty())
+			{
+				m_completed = m_queued.front();
+				m_queued.pop_front();
+			}
+		}
+		// what a blocking fence wait does
+		void WaitFor( uint64_t value )
+		{
+			while (m_completed < value)
+			{
+				++m_waitSteps;
+				Step();
+			}
+		}
+		uint64_t GetCompletedValue() const
+		{
+			return m_completed;
+		}
+		size_t GetQueuedCount() const
+		{
+			return m_queued.size();
+		}
+		uint32_t GetWaitSteps() const
+		{
+			return m_waitSteps;
+		}
+	private:
+		std::deque<uint64_t> m_queued;
+		uint64_t m_signalled = 0u;
+		uint64_t m_completed = 0u;
+		uint32_t m_waitSteps = 0u;
+	};
+
+	// the frame loop of DXContext: wait for the slot, record, submit, advance
+	void RunFrame( FrameRing& ring, MockQueue& queue, std::vector<uint64_t>& slotWork )
+	{
+		if (ring.NeedsWait( queue.GetCompletedValue() ))
+		{
+			queue.WaitFor( ring.GetWaitValue() );
+		}
+		// the allocator of this slot gets reset here, the GPU must be done with it
+		EXODUS_CHECK( slotWork[ring.GetCurrentSlot()] <= queue.GetCompletedValue() );
+		const uint64_t value = queue.Signal();
+		slotWork[ring.GetCurrentSlot()] = value;
+		ring.MarkSubmitted( value );
+		EXODUS_CHECK( ring.GetLastSubmittedValue() == value );
+		ring.Advance();
+	}
+
+	void TestFreshRing()
+	{
+		FrameRing ring( 3u );
+		EXODUS_CHECK( ring.GetFrameCount() == 3u );
+		EXODUS_CHECK( ring.GetCurrentSlot() == 0u );
+		EXODUS_CHECK( ring.GetWaitValue() == 0u );
+		EXODUS_CHECK( !ring.NeedsWait( 0u ) );
+		EXODUS_CHECK( FrameRing( 0u ).GetFrameCount() == 1u );
+	}
+
+	void TestStalledGpu()
+	{
+		// the GPU makes no progress on its own, the CPU gets exactly frameCount frames ahead
+		for (uint32_t frames = 1u; frames <= 4u; ++frames)
+		{
+			FrameRing ring( frames );
+			MockQueue queue;
+			std::vector<uint64_t> slotWork( frames, 0u );
+			for (uint32_t i = 0u; i < frames; ++i)
+			{
+				RunFrame( ring, queue, slotWork );
+			}
+			EXODUS_CHECK( queue.GetWaitSteps() == 0u );
+			EXODUS_CHECK( queue.GetQueuedCount() == frames );
+			// the next frame reuses slot 0 and only waits for the first submission
+			RunFrame( ring, queue, slotWork );
+			EXODUS_CHECK( queue.GetWaitSteps() == 1u );
+			EXODUS_CHECK( queue.GetQueuedCount() == frames );
+		}
+	}
+
+	void TestLaggingGpu()
+	{
+		FrameRing ring( 2u );
+		MockQueue queue;
+		std::vector<uint64_t> slotWork( 2u, 0u );
+		for (uint32_t frame = 0u; frame < 1000u; ++frame)
+		{
+			RunFrame( ring, queue, slotWork );
+			// the GPU finishes a frame every other CPU frame
+			if (frame % 2u == 0u)
+			{
+				queue.Step();
+			}
+			EXODUS_CHECK( queue.GetQueuedCount() <= 2u );
+		}
+		EXODUS_CHECK( ring.GetCurrentSlot() == 0u );
+	}
+
+	void TestReset()
+	{
+		FrameRing ring( 2u );
+		ring.MarkSubmitted( 5u );
+		ring.Advance();
+		ring.Reset();
+		EXODUS_CHECK( ring.GetCurrentSlot() == 0u );
+		EXODUS_CHECK( ring.GetWaitValue() == 0u );
+		EXODUS_CHECK( ring.GetLastSubmittedValue() == 0u );
+	}
+}
+
+int main()
+{
+	TestFreshRing();
+	TestStalledGpu();
+	TestLaggingGpu();
+	TestReset();
+	return EXODUS_TEST_RESULT();
+}
@@ -0,0 +1,146 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Input/InputLog.h"
+#include "TestCheck.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	const char* const logPath = "InputLogTest.exil";
+
+	InputEvent MakeEvent( InputEvent::Type type, uint8_t code, bool down, int x, int y, uint64_t timestamp )
+	{
+		InputEvent e;
+		e.type = type;
+		e.code = code;
+		e.down = down;
+		e.x = x;
+		e.y = y;
+		e.timestamp = timestamp;
+		return e;
+	}
+
+	// the fields each event type stores, the rest comes back as the default or the frame time
+	bool SameEvent( const InputEvent& a, const InputEvent& b )
+	{
+		if (a.type != b.type)
+		{
+			return false;
+		}
+		switch (a.type)
+		{
+		case InputEvent::Type::Key:
+		case InputEvent::Type::Button:
+			return a.code == b.code && a.down == b.down && a.timestamp == b.timestamp;
+		case InputEvent::Type::Char:
+			return a.code == b.code;
+		case InputEvent::Type::MouseMove:
+			return a.x == b.x && a.y == b.y && a.timestamp == b.timestamp;
+		case InputEvent::Type::MouseInWindow:
+			return a.down == b.down;
+		case InputEvent::Type::Wheel:
+			return a.x == b.x;
+		case InputEvent::Type::RawDelta:
+			return a.x == b.x && a.y == b.y;
+		}
+		return false;
+	}
+
+	std::vector<InputFrame> MakeFrames()
+	{
+		std::vector<InputFrame> frames( 3u );
+		frames[0].deltaTime = 1.0f / 60.0f;
+		frames[0].timestamp = 1000000u;
+		frames[0].events.push_back( MakeEvent( InputEvent::Type::Key, 'W', true, 0, 0, 999500u ) );
+		frames[0].events.push_back( MakeEvent( InputEvent::Type::Char, 'w', false, 0, 0, 999500u ) );
+		frames[0].events.push_back( MakeEvent( InputEvent::Type::MouseMove, 0u, false, 640, -12, 999800u ) );
+		frames[0].events.push_back( MakeEvent( InputEvent::Type::MouseInWindow, 0u, true, 0, 0, 999800u ) );
+		// no events, a delta time that isn't exact in binary
+		frames[1].deltaTime = 0.0166671f;
+		frames[1].timestamp = 1016667u;
+		frames[2].deltaTime = 0.02f;
+		frames[2].timestamp = 1036667u;
+		frames[2].events.push_back( MakeEvent( InputEvent::Type::Button, 1u, true, 0, 0, 1036000u ) );
+		frames[2].events.push_back( MakeEvent( InputEvent::Type::Wheel, 0u, false, -3, 0, 1036000u ) );
+		frames[2].events.push_back( MakeEvent( InputEvent::Type::RawDelta, 0u, false, -70000, 42, 1036000u ) );
+		frames[2].events.push_back( MakeEvent( InputEvent::Type::Key, 'W', false, 0, 0, 1036500u ) );
+		return frames;
+	}
+
+	void TestRoundTrip()
+	{
+		const std::vector<InputFrame> frames = MakeFrames();
+		InputRecorder recorder;
+		EXODUS_CHECK( recorder.Open( logPath ) );
+		for (const InputFrame& frame : frames)
+		{
+			recorder.WriteFrame( frame );
+		}
+		recorder.Close();
+		EXODUS_CHECK( recorder.GetFrameCount() == frames.size() );
+
+		InputPlayer player;
+		EXODUS_CHECK( player.Open( logPath ) );
+		InputFrame frame;
+		for (const InputFrame& expected : frames)
+		{
+			EXODUS_CHECK( player.ReadFrame( frame ) );
+			// delta times are stored bit for bit
+			EXODUS_CHECK( std::memcmp( &frame.deltaTime, &expected.deltaTime, sizeof( float ) ) == 0 );
+			EXODUS_CHECK( frame.timestamp == expected.timestamp );
+			EXODUS_CHECK( frame.events.size() == expected.events.size() );
+			for (size_t i = 0u; i < frame.events.size() && i < expected.events.size(); ++i)
+			{
+				EXODUS_CHECK( SameEvent( frame.events[i], expected.events[i] ) );
+			}
+		}
+		EXODUS_CHECK( player.GetFrameIndex() == frames.size() );
+		// the log is exhausted
+		EXODUS_CHECK( !player.ReadFrame( frame ) );
+	}
+
+	void TestNotALog()
+	{
+		std::FILE* file = std::fopen( logPath, "wb" );
+		EXODUS_CHECK( file != nullptr );
+		if (file)
+		{
+			std::fputs( "not an input log", file );
+			std::fclose( file );
+		}
+		InputPlayer player;
+		EXODUS_CHECK( !player.Open( logPath ) );
+		EXODUS_CHECK( !player.Open( "InputLogTest.missing" ) );
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestNotALog();
+	std::remove( logPath );
+	return EXODUS_TEST_RESULT();
+}
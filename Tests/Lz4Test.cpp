@@ -0,0 +1,92 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Support/Lz4.h"
+#include "TestCheck.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	bool RoundTrip( const std::vector<std::byte>& source )
+	{
+		std::vector<std::byte> compressed( Lz4::GetMaxCompressedSize( source.size() ) );
+		const size_t size = Lz4::Compress( source.data(), source.size(), compressed.data(), compressed.size() );
+		if (size == 0u)
+		{
+			return false;
+		}
+		std::vector<std::byte> restored( source.size() );
+		return Lz4::Decompress( compressed.data(), size, restored.data(), restored.size() ) && restored == source;
+	}
+
+	void TestEmpty()
+	{
+		// empty vectors hand out null data, nothing may be copied from or to it
+		std::byte block[16];
+		const size_t size = Lz4::Compress( nullptr, 0u, block, sizeof( block ) );
+		EXODUS_CHECK( size == 1u );
+		EXODUS_CHECK( Lz4::Decompress( block, size, nullptr, 0u ) );
+		EXODUS_CHECK( RoundTrip( {} ) );
+	}
+
+	void TestRoundTrips()
+	{
+		std::vector<std::byte> text;
+		const char* const line = "the quick brown fox jumps over the lazy dog ";
+		for (int i = 0; i < 1000; ++i)
+		{
+			for (const char* c = line; *c; ++c)
+			{
+				text.push_back( std::byte( *c ) );
+			}
+		}
+		EXODUS_CHECK( RoundTrip( text ) );
+		std::vector<std::byte> noise( 100000u );
+		uint32_t state = 12345u;
+		for (std::byte& value : noise)
+		{
+			state = state * 1664525u + 1013904223u;
+			value = std::byte( state >> 24u );
+		}
+		EXODUS_CHECK( RoundTrip( noise ) );
+		EXODUS_CHECK( RoundTrip( { std::byte( 7 ) } ) );
+	}
+
+	void TestMalformed()
+	{
+		// a literal run longer than the output
+		const std::byte block[] = { std::byte( 0x50 ), std::byte( 1 ), std::byte( 2 ), std::byte( 3 ), std::byte( 4 ), std::byte( 5 ) };
+		std::byte output[4];
+		EXODUS_CHECK( !Lz4::Decompress( block, sizeof( block ), output, sizeof( output ) ) );
+		EXODUS_CHECK( !Lz4::Decompress( block, sizeof( block ), nullptr, 0u ) );
+	}
+}
+
+int main()
+{
+	TestEmpty();
+	TestRoundTrips();
+	TestMalformed();
+	return EXODUS_TEST_RESULT();
+}
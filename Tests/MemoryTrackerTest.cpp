@@ -0,0 +1,127 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Memory/MemoryTracker.h"
+#include "Memory/TrackedAllocator.h"
+#include "TestCheck.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	void TestCounters()
+	{
+		MemoryTracker& tracker = MemoryTracker::Get();
+		tracker.OnAllocate( MemoryTag::GpuUpload, 100u );
+		tracker.OnAllocate( MemoryTag::GpuUpload, 50u );
+		tracker.OnFree( MemoryTag::GpuUpload, 100u );
+		MemoryTracker::TagStats stats = tracker.GetStats( MemoryTag::GpuUpload );
+		EXODUS_CHECK( stats.liveBytes == 50u && stats.liveAllocations == 1u && stats.totalAllocations == 2u );
+		// the peak stays where it was
+		EXODUS_CHECK( stats.peakBytes == 150u );
+		tracker.OnAllocate( MemoryTag::GpuUpload, 200u );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::GpuUpload ).peakBytes == 250u );
+		tracker.OnFree( MemoryTag::GpuUpload, 200u );
+		tracker.OnFree( MemoryTag::GpuUpload, 50u );
+		stats = tracker.GetStats( MemoryTag::GpuUpload );
+		EXODUS_CHECK( stats.liveBytes == 0u && stats.liveAllocations == 0u && stats.peakBytes == 250u );
+		// other tags are untouched
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::ImGui ).totalAllocations == 0u );
+
+		// Allocate() remembers the size for Free()
+		void* p = tracker.Allocate( MemoryTag::ImGui, 24u );
+		std::memset( p, 0xAB, 24u );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::ImGui ).liveBytes == 24u );
+		tracker.Free( MemoryTag::ImGui, p );
+		tracker.Free( MemoryTag::ImGui, nullptr );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::ImGui ).liveBytes == 0u && tracker.GetStats( MemoryTag::ImGui ).liveAllocations == 0u );
+	}
+
+	void TestFrameRollover()
+	{
+		MemoryTracker& tracker = MemoryTracker::Get();
+		tracker.FrameBoundary();
+		{
+			std::vector<int, TrackedAllocator<int, MemoryTag::Input>> values;
+			values.reserve( 16u );
+			EXODUS_CHECK( tracker.GetStats( MemoryTag::Input ).liveBytes == 16u * sizeof( int ) );
+			// the frame isn't closed yet, the last completed frame had nothing
+			EXODUS_CHECK( tracker.GetStats( MemoryTag::Input ).frameAllocations == 0u );
+			tracker.FrameBoundary();
+		}
+		MemoryTracker::TagStats stats = tracker.GetStats( MemoryTag::Input );
+		EXODUS_CHECK( stats.frameAllocations == 1u && stats.frameBytes == 16u * sizeof( int ) && stats.liveBytes == 0u );
+		tracker.FrameBoundary();
+		stats = tracker.GetStats( MemoryTag::Input );
+		EXODUS_CHECK( stats.frameAllocations == 0u && stats.frameBytes == 0u && stats.totalAllocations == 1u );
+	}
+
+	void TestBudget()
+	{
+		MemoryTracker& tracker = MemoryTracker::Get();
+		// unlimited by default
+		tracker.OnAllocate( MemoryTag::Assets, 1000u );
+		EXODUS_CHECK( !tracker.IsOverBudget( MemoryTag::Assets ) && !tracker.IsAnyOverBudget() );
+		tracker.SetBudget( MemoryTag::Assets, 1000u );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::Assets ).budget == 1000u );
+		EXODUS_CHECK( !tracker.IsOverBudget( MemoryTag::Assets ) );
+		tracker.OnAllocate( MemoryTag::Assets, 1u );
+		EXODUS_CHECK( tracker.IsOverBudget( MemoryTag::Assets ) && tracker.IsAnyOverBudget() );
+		EXODUS_CHECK( !tracker.IsOverBudget( MemoryTag::ECS ) );
+		tracker.OnFree( MemoryTag::Assets, 1u );
+		EXODUS_CHECK( !tracker.IsOverBudget( MemoryTag::Assets ) );
+		tracker.OnFree( MemoryTag::Assets, 1000u );
+		tracker.SetBudget( MemoryTag::Assets, 0u );
+	}
+
+	struct Subsystem
+	{
+		explicit Subsystem( int value ) : value( value )
+		{
+		}
+		int value;
+		char payload[60];
+	};
+
+	void TestTrackedNew()
+	{
+		MemoryTracker& tracker = MemoryTracker::Get();
+		const size_t before = tracker.GetStats( MemoryTag::General ).liveBytes;
+		Subsystem* subsystem = TrackedNew<MemoryTag::General, Subsystem>( 7 );
+		EXODUS_CHECK( subsystem->value == 7 );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::General ).liveBytes == before + sizeof( Subsystem ) );
+		TrackedDelete<MemoryTag::General>( subsystem );
+		TrackedDelete<MemoryTag::General>( static_cast<Subsystem*>(nullptr) );
+		EXODUS_CHECK( tracker.GetStats( MemoryTag::General ).liveBytes == before );
+		EXODUS_CHECK( tracker.GetTotalLiveBytes() == 0u );
+	}
+}
+
+int main()
+{
+	TestCounters();
+	TestFrameRollover();
+	TestBudget();
+	TestTrackedNew();
+	return EXODUS_TEST_RESULT();
+}
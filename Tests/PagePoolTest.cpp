@@ -0,0 +1,102 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Memory/PagePool.h"
+#include "TestCheck.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	struct Block
+	{
+		void* p;
+		size_t bytes;
+	};
+
+	void TestReuseAcrossSizes()
+	{
+		PagePool& pool = PagePool::Get();
+		std::vector<Block> blocks;
+		// one slab per size, more than the pool keeps around empty
+		for (size_t bytes = PagePool::blockGranularity; bytes <= PagePool::maxBlockSize; bytes += PagePool::blockGranularity)
+		{
+			void* p = pool.Allocate( bytes );
+			EXODUS_CHECK( reinterpret_cast<uintptr_t>(p) % PagePool::blockGranularity == 0u );
+			std::memset( p, 0xCD, bytes );
+			blocks.push_back( { p, bytes } );
+		}
+		EXODUS_CHECK( pool.GetStats().slabCount == PagePool::classCount );
+		EXODUS_CHECK( pool.GetStats().liveBytes > 0u );
+		for (const Block& block : blocks)
+		{
+			pool.Free( block.p, block.bytes );
+		}
+		// empty slabs are released down to the retained few
+		EXODUS_CHECK( pool.GetStats().liveBytes == 0u );
+		EXODUS_CHECK( pool.GetStats().slabCount == PagePool::retainedSlabs );
+
+		// and a different size picks them up again
+		void* p = pool.Allocate( 12u * 1024u );
+		EXODUS_CHECK( pool.GetStats().slabCount == PagePool::retainedSlabs );
+		pool.Free( p, 12u * 1024u );
+	}
+
+	void TestFullSlabs()
+	{
+		PagePool& pool = PagePool::Get();
+		std::vector<Block> blocks;
+		// 256 KB blocks, the header costs each slab one of eight
+		for (int i = 0; i < 70; ++i)
+		{
+			blocks.push_back( { pool.Allocate( PagePool::maxBlockSize ), PagePool::maxBlockSize } );
+		}
+		EXODUS_CHECK( pool.GetStats().slabCount == 10u );
+		EXODUS_CHECK( pool.GetStats().liveBytes == 70u * PagePool::maxBlockSize );
+		// every other block, the slabs stay partly used and take blocks back
+		for (size_t i = 0u; i < blocks.size(); i += 2u)
+		{
+			pool.Free( blocks[i].p, blocks[i].bytes );
+			blocks[i].p = nullptr;
+		}
+		EXODUS_CHECK( pool.GetStats().slabCount == 10u );
+		for (size_t i = 0u; i < blocks.size(); i += 2u)
+		{
+			blocks[i].p = pool.Allocate( PagePool::maxBlockSize );
+		}
+		EXODUS_CHECK( pool.GetStats().slabCount == 10u );
+		for (const Block& block : blocks)
+		{
+			pool.Free( block.p, block.bytes );
+		}
+		EXODUS_CHECK( pool.GetStats().liveBytes == 0u );
+		EXODUS_CHECK( pool.GetStats().slabCount == PagePool::retainedSlabs );
+	}
+}
+
+int main()
+{
+	TestReuseAcrossSizes();
+	TestFullSlabs();
+	return EXODUS_TEST_RESULT();
+}
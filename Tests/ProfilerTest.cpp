@@ -0,0 +1,90 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Profiling/Profiler.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Exodus;
+
+namespace
+{
+	const char* const zoneName = "Zone";
+
+	void RecordZones( uint32_t count )
+	{
+		for (uint32_t i = 0u; i < count; ++i)
+		{
+			ProfileScope scope( zoneName );
+		}
+	}
+
+	void TestLappedRing()
+	{
+		// one ring holds 1 << 16 zones, the oldest of the rest are dropped
+		Profiler& profiler = Profiler::Get();
+		profiler.FrameBoundary();
+		const uint64_t droppedBefore = profiler.GetDroppedZones();
+		RecordZones( 70000u );
+		profiler.FrameBoundary();
+		const Profiler::FrameCapture* capture = profiler.GetCapture( 0u );
+		EXODUS_CHECK( capture && capture->zones.size() == 65536u );
+		EXODUS_CHECK( profiler.GetDroppedZones() - droppedBefore == 70000u - 65536u );
+	}
+
+	void TestConcurrentDrain()
+	{
+		// the worker laps the reader over and over, every zone that makes it out has to be whole
+		Profiler& profiler = Profiler::Get();
+		std::atomic<bool> done = false;
+		std::thread worker( [&done]()
+		{
+			EXODUS_PROFILE_THREAD( "Worker" );
+			RecordZones( 2000000u );
+			done = true;
+		} );
+		size_t zones = 0u;
+		bool valid = true;
+		while (!done)
+		{
+			profiler.FrameBoundary();
+			for (const Profiler::Zone& zone : profiler.GetCapture( 0u )->zones)
+			{
+				valid &= zone.name == zoneName && zone.start <= zone.end && zone.depth == 0u;
+			}
+			zones += profiler.GetCapture( 0u )->zones.size();
+		}
+		worker.join();
+		profiler.FrameBoundary();
+		zones += profiler.GetCapture( 0u )->zones.size();
+		EXODUS_CHECK( valid );
+		EXODUS_CHECK( zones > 0u && zones <= 2000000u );
+	}
+}
+
+int main()
+{
+	EXODUS_PROFILE_THREAD( "Main" );
+	TestLappedRing();
+	TestConcurrentDrain();
+	return EXODUS_TEST_RESULT();
+}
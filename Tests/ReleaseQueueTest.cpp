@@ -0,0 +1,132 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "D3D/ReleaseQueue.h"
+#include "TestCheck.h"
+
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	// stands in for a COM object, logs its id when the queue drops its reference
+	struct FakeObject
+	{
+		void Release()
+		{
+			--references;
+			log->push_back( id );
+		}
+		int id = 0;
+		int references = 1;
+		std::vector<int>* log = nullptr;
+	};
+
+	// the GPU side of a fence timeline, completes values in order
+	struct FakeFence
+	{
+		uint64_t completed = 0u;
+		uint64_t next = 1u;
+	};
+
+	void TestInOrder()
+	{
+		std::vector<int> log;
+		std::vector<FakeObject> objects( 4u );
+		FakeFence fence;
+		ReleaseQueue queue;
+		for (int i = 0; i < 4; ++i)
+		{
+			objects[i].id = i;
+			objects[i].log = &log;
+			// two objects per submission
+			queue.Retire( &objects[i], fence.next + static_cast<uint64_t>(i / 2) );
+		}
+		queue.Retire( static_cast<FakeObject*>(nullptr), fence.next );
+		EXODUS_CHECK( queue.GetPendingCount() == 4u );
+		EXODUS_CHECK( queue.Release( fence.completed ) == 0u );
+		fence.completed = 1u;
+		EXODUS_CHECK( queue.Release( fence.completed ) == 2u );
+		EXODUS_CHECK( (log == std::vector<int>{ 0, 1 }) );
+		// nothing new
+		EXODUS_CHECK( queue.Release( fence.completed ) == 0u );
+		fence.completed = 2u;
+		EXODUS_CHECK( queue.Release( fence.completed ) == 2u );
+		EXODUS_CHECK( (log == std::vector<int>{ 0, 1, 2, 3 }) && queue.GetPendingCount() == 0u );
+		for (const FakeObject& object : objects)
+		{
+			EXODUS_CHECK( object.references == 0 );
+		}
+	}
+
+	void TestReleaseAll()
+	{
+		std::vector<int> log;
+		FakeObject a{ 1, 1, &log };
+		FakeObject b{ 2, 1, &log };
+		FakeObject c{ 3, 1, &log };
+		{
+			ReleaseQueue queue;
+			queue.Retire( &a, 5u );
+			queue.Retire( &b, 9u );
+			EXODUS_CHECK( queue.ReleaseAll() == 2u );
+			EXODUS_CHECK( (log == std::vector<int>{ 1, 2 }) && queue.GetPendingCount() == 0u );
+			EXODUS_CHECK( queue.ReleaseAll() == 0u );
+			// whatever is left goes with the queue
+			queue.Retire( &c, 100u );
+		}
+		EXODUS_CHECK( (log == std::vector<int>{ 1, 2, 3 }) );
+		EXODUS_CHECK( a.references == 0 && b.references == 0 && c.references == 0 );
+	}
+
+	void TestOutOfOrder()
+	{
+		// a job drops an object ahead of the frame, tagged with the next fence value, then
+		// the frame retires what it just submitted with the current one
+		std::vector<int> log;
+		FakeObject early{ 1, 1, &log };
+		FakeObject frame{ 2, 1, &log };
+		FakeObject later{ 3, 1, &log };
+		FakeFence fence;
+		fence.next = 10u;
+		ReleaseQueue queue;
+		queue.Retire( &early, fence.next + 1u );
+		queue.Retire( &frame, fence.next );
+		queue.Retire( &later, fence.next + 1u );
+		fence.completed = fence.next;
+		EXODUS_CHECK( queue.Release( fence.completed ) == 1u );
+		EXODUS_CHECK( (log == std::vector<int>{ 2 }) && queue.GetPendingCount() == 2u );
+		// never early
+		EXODUS_CHECK( early.references == 1 && later.references == 1 );
+		fence.completed = fence.next + 1u;
+		EXODUS_CHECK( queue.Release( fence.completed ) == 2u );
+		// the rest keep the order they were retired in
+		EXODUS_CHECK( (log == std::vector<int>{ 2, 1, 3 }) && queue.GetPendingCount() == 0u );
+	}
+}
+
+int main()
+{
+	TestInOrder();
+	TestReleaseAll();
+	TestOutOfOrder();
+	return EXODUS_TEST_RESULT();
+}
@@ -0,0 +1,164 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "Support/ResizeCoalescer.h"
+#include "TestCheck.h"
+
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	constexpr uint64_t millisecond = 1'000'000ull;
+	constexpr uint64_t minInterval = 50u * millisecond;
+
+	bool Equal( ResizeCoalescer::Size a, uint32_t width, uint32_t height )
+	{
+		return a.width == width && a.height == height;
+	}
+
+	void TestSingleRequests()
+	{
+		ResizeCoalescer resize( minInterval );
+		ResizeCoalescer::Size size;
+		resize.Reset( 800u, 600u );
+		EXODUS_CHECK( !resize.Poll( 0u, size ) );
+		// after a quiet period a resize goes through right away
+		resize.Request( 1024u, 768u );
+		EXODUS_CHECK( resize.Poll( 10u * millisecond, size ) && Equal( size, 1024u, 768u ) );
+		// the next one waits out the interval
+		resize.Request( 1280u, 720u );
+		EXODUS_CHECK( !resize.Poll( 20u * millisecond, size ) && resize.IsPending() );
+		EXODUS_CHECK( resize.Poll( 60u * millisecond, size ) && Equal( size, 1280u, 720u ) );
+		// minimised, and back to the size already applied
+		resize.Request( 0u, 0u );
+		resize.Request( 1280u, 0u );
+		EXODUS_CHECK( !resize.IsPending() );
+		resize.Request( 1280u, 720u );
+		EXODUS_CHECK( !resize.Poll( 500u * millisecond, size ) && !resize.IsPending() );
+		EXODUS_CHECK( resize.GetStats().requests == 5u && resize.GetStats().applied == 2u );
+		// Reset() takes the size the swap chain was created with and drops the pending one
+		resize.Request( 640u, 480u );
+		resize.Reset( 640u, 480u );
+		EXODUS_CHECK( !resize.IsPending() && Equal( resize.GetCurrent(), 640u, 480u ) );
+	}
+
+	void TestRetry()
+	{
+		ResizeCoalescer resize( minInterval );
+		ResizeCoalescer::Size size;
+		resize.Reset( 800u, 600u );
+		resize.Request( 1024u, 768u );
+		EXODUS_CHECK( resize.Poll( 0u, size ) );
+		resize.Retry();
+		EXODUS_CHECK( resize.IsPending() && Equal( resize.GetCurrent(), 0u, 0u ) );
+		// retried after the interval, not straight away
+		EXODUS_CHECK( !resize.Poll( 10u * millisecond, size ) );
+		EXODUS_CHECK( resize.Poll( 50u * millisecond, size ) && Equal( size, 1024u, 768u ) );
+		resize.Retry();
+		// a newer request replaces the failed size, even the one from before the failure
+		resize.Request( 800u, 600u );
+		EXODUS_CHECK( resize.Poll( 100u * millisecond, size ) && Equal( size, 800u, 600u ) );
+		EXODUS_CHECK( resize.GetStats().failed == 2u && resize.GetStats().applied == 3u );
+		// nothing handed out yet, nothing to retry
+		ResizeCoalescer fresh( minInterval );
+		fresh.Reset( 800u, 600u );
+		fresh.Retry();
+		EXODUS_CHECK( !fresh.IsPending() && fresh.GetStats().failed == 0u );
+	}
+
+	struct SizeMessage
+	{
+		double milliseconds;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	// WM_SIZE messages of a corner drag: out, a pause with the button held, back in a little.
+	// 8 ms apart with the odd gap of a skipped message, the cadence Windows sends them at
+	// while the modal size loop runs.
+	const SizeMessage dragBurst[] = {
+		{ 8.0, 1284, 720 }, { 24.1, 1289, 723 }, { 32.1, 1291, 723 }, { 39.9, 1296, 725 }, { 47.7, 1299, 727 },
+		{ 55.8, 1302, 727 }, { 63.9, 1305, 727 }, { 80.0, 1309, 729 }, { 88.0, 1312, 731 }, { 96.1, 1316, 731 },
+		{ 111.7, 1320, 734 }, { 127.3, 1323, 735 }, { 135.3, 1328, 737 }, { 143.1, 1332, 737 }, { 151.2, 1336, 738 },
+		{ 159.5, 1341, 740 }, { 167.8, 1346, 741 }, { 175.8, 1350, 743 }, { 183.6, 1352, 743 }, { 191.9, 1356, 746 },
+		{ 208.0, 1360, 747 }, { 224.1, 1363, 747 }, { 232.4, 1366, 750 }, { 240.5, 1369, 752 }, { 248.8, 1373, 753 },
+		{ 256.9, 1375, 753 }, { 273.0, 1378, 755 }, { 288.6, 1381, 755 }, { 296.7, 1384, 757 }, { 305.0, 1386, 757 },
+		{ 313.1, 1388, 759 }, { 329.2, 1392, 759 }, { 337.3, 1396, 761 }, { 345.3, 1401, 761 }, { 353.4, 1404, 764 },
+		{ 361.5, 1407, 766 }, { 369.8, 1410, 768 }, { 385.4, 1412, 770 }, { 393.2, 1417, 771 }, { 401.3, 1421, 773 },
+		{ 416.9, 1423, 776 }, { 424.9, 1428, 777 }, { 432.7, 1430, 777 }, { 440.5, 1433, 778 }, { 456.1, 1435, 781 },
+		{ 471.7, 1438, 783 }, { 479.5, 1440, 785 }, { 487.8, 1443, 788 }, { 495.8, 1446, 791 }, { 504.1, 1451, 791 },
+		{ 512.1, 1456, 794 }, { 520.1, 1461, 795 }, { 528.4, 1464, 795 }, { 536.2, 1468, 797 }, { 544.2, 1471, 798 },
+		{ 552.5, 1475, 799 }, { 560.6, 1477, 801 }, { 576.2, 1479, 804 }, { 592.3, 1481, 807 }, { 600.6, 1483, 810 },
+		{ 848.6, 1480, 810 }, { 856.8, 1478, 808 }, { 872.8, 1475, 807 }, { 888.8, 1472, 807 }, { 897.0, 1470, 806 },
+		{ 913.0, 1469, 805 }, { 921.0, 1468, 804 }, { 929.0, 1466, 802 }, { 936.9, 1465, 800 }, { 952.9, 1462, 799 },
+		{ 968.9, 1460, 799 }, { 976.8, 1459, 799 }, { 984.7, 1456, 798 }, { 992.6, 1454, 797 }, { 1000.6, 1451, 797 },
+		{ 1008.6, 1450, 795 }, { 1016.8, 1447, 794 }, { 1032.8, 1446, 794 }, { 1040.7, 1443, 792 }, { 1048.6, 1441, 790 },
+		{ 1056.8, 1438, 790 }, { 1064.7, 1436, 790 }, { 1072.6, 1434, 789 }, { 1080.5, 1433, 787 }, { 1096.5, 1431, 787 },
+		{ 1104.7, 1429, 787 }, { 1120.7, 1427, 787 }, { 1128.6, 1426, 785 }, { 1136.8, 1423, 784 }, { 1152.8, 1420, 783 },
+	};
+
+	// replays the burst against 60 Hz frames, the way Win32Backend::BeginFrame() feeds it
+	void TestDragReplay()
+	{
+		constexpr size_t messageCount = sizeof( dragBurst ) / sizeof( dragBurst[0] );
+		ResizeCoalescer resize( minInterval );
+		resize.Reset( 1280u, 720u );
+		std::vector<uint64_t> appliedAt;
+		ResizeCoalescer::Size size;
+		size_t next = 0u;
+		for (double frame = 0.0; frame < 1500.0; frame += 1000.0 / 60.0)
+		{
+			for (; next < messageCount && dragBurst[next].milliseconds <= frame; ++next)
+			{
+				resize.Request( dragBurst[next].width, dragBurst[next].height );
+			}
+			const uint64_t now = static_cast<uint64_t>(frame * static_cast<double>(millisecond));
+			if (resize.Poll( now, size ))
+			{
+				appliedAt.push_back( now );
+			}
+		}
+		const SizeMessage& last = dragBurst[messageCount - 1u];
+		EXODUS_CHECK( resize.GetStats().requests == messageCount );
+		EXODUS_CHECK( !resize.IsPending() && Equal( resize.GetCurrent(), last.width, last.height ) );
+		// the first message of the drag isn't held back
+		EXODUS_CHECK( !appliedAt.empty() && appliedAt.front() < 20u * millisecond );
+		bool spaced = true;
+		for (size_t i = 1u; i < appliedAt.size(); ++i)
+		{
+			spaced &= appliedAt[i] - appliedAt[i - 1u] >= minInterval;
+		}
+		EXODUS_CHECK( spaced );
+		// about one resize per interval while dragging, instead of one per message
+		EXODUS_CHECK( appliedAt.size() >= 15u && appliedAt.size() <= 25u );
+		// the last size arrives within an interval and a frame of the last message
+		EXODUS_CHECK( appliedAt.back() <= static_cast<uint64_t>((last.milliseconds + 70.0) * static_cast<double>(millisecond)) );
+	}
+}
+
+int main()
+{
+	TestSingleRequests();
+	TestRetry();
+	TestDragReplay();
+	return EXODUS_TEST_RESULT();
+}
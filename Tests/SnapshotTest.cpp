@@ -0,0 +1,190 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "ECS/Snapshot.h"
+#include "TestCheck.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Exodus;
+
+namespace
+{
+	struct Position
+	{
+		float x, y, z;
+	};
+
+	// not trivially copyable, saved through the archive path
+	struct Name
+	{
+		std::string text;
+	};
+
+	void Serialize( SnapshotOutput& out, const Name& value )
+	{
+		out.WriteString( value.text );
+	}
+
+	void Deserialize( SnapshotInput& in, Name& value )
+	{
+		value.text = in.ReadString();
+	}
+
+	const char* const snapshotPath = "SnapshotTest.snap";
+
+	std::vector<char> ReadFile( const char* path )
+	{
+		std::ifstream file( path, std::ios::binary );
+		return std::vector<char>( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+	}
+
+	void WriteFile( const char* path, const std::vector<char>& bytes )
+	{
+		std::ofstream file( path, std::ios::binary | std::ios::trunc );
+		file.write( bytes.data(), static_cast<std::streamsize>(bytes.size()) );
+	}
+
+	void TestRoundTrip()
+	{
+		Registry saved;
+		std::vector<entt::entity> entities;
+		for (int i = 0; i < 120; ++i)
+		{
+			entities.push_back( saved.create() );
+		}
+		// recycle some ids so their versions are not 0, and leave a few destroyed
+		for (int i = 0; i < 120; i += 6)
+		{
+			saved.destroy( entities[i] );
+		}
+		for (int i = 0; i < 120; i += 12)
+		{
+			entities[i] = saved.create();
+		}
+		for (size_t i = 0u; i < entities.size(); ++i)
+		{
+			if (!saved.valid( entities[i] ))
+			{
+				continue;
+			}
+			if (i % 5u != 0u)
+			{
+				const float value = static_cast<float>(i);
+				saved.emplace<Position>( entities[i], value, value * 2.0f, -value );
+			}
+			if (i % 3u == 0u)
+			{
+				saved.emplace<Name>( entities[i], "entity " + std::to_string( i ) + (i % 2u ? std::string( 40u, '#' ) : std::string()) );
+			}
+		}
+		EXODUS_CHECK( (RegistrySnapshot::Save<Position, Name>( saved, snapshotPath )) );
+		Registry loaded;
+		EXODUS_CHECK( (RegistrySnapshot::Load<Position, Name>( loaded, snapshotPath )) );
+		EXODUS_CHECK( loaded.storage<Position>().size() == saved.storage<Position>().size() );
+		EXODUS_CHECK( loaded.storage<Name>().size() == saved.storage<Name>().size() );
+		for (size_t i = 0u; i < entities.size(); ++i)
+		{
+			const entt::entity entity = entities[i];
+			EXODUS_CHECK( loaded.valid( entity ) == saved.valid( entity ) );
+			if (!saved.valid( entity ))
+			{
+				continue;
+			}
+			EXODUS_CHECK( loaded.current( entity ) == saved.current( entity ) );
+			EXODUS_CHECK( loaded.all_of<Position>( entity ) == saved.all_of<Position>( entity ) );
+			if (saved.all_of<Position>( entity ) && loaded.all_of<Position>( entity ))
+			{
+				const Position& a = saved.get<Position>( entity );
+				const Position& b = loaded.get<Position>( entity );
+				EXODUS_CHECK( a.x == b.x && a.y == b.y && a.z == b.z );
+			}
+			EXODUS_CHECK( loaded.all_of<Name>( entity ) == saved.all_of<Name>( entity ) );
+			if (saved.all_of<Name>( entity ) && loaded.all_of<Name>( entity ))
+			{
+				EXODUS_CHECK( loaded.get<Name>( entity ).text == saved.get<Name>( entity ).text );
+			}
+		}
+		// the next id handed out is the same, the free list came along
+		EXODUS_CHECK( loaded.create() == saved.create() );
+	}
+
+	// the pool's count follows its type hash, size and mode
+	size_t FindCount( const std::vector<char>& bytes )
+	{
+		const uint32_t pool[2] = { static_cast<uint32_t>(entt::type_hash<Position>::value()), static_cast<uint32_t>(sizeof( Position )) };
+		for (size_t i = 0u; i + sizeof( pool ) + 1u + sizeof( uint64_t ) <= bytes.size(); ++i)
+		{
+			if (std::memcmp( bytes.data() + i, pool, sizeof( pool ) ) == 0)
+			{
+				return i + sizeof( pool ) + 1u;
+			}
+		}
+		return bytes.size();
+	}
+
+	void TestCorruptCount()
+	{
+		// only the one pool, a count past it runs into the end of the file
+		Registry saved;
+		for (int i = 0; i < 100; ++i)
+		{
+			saved.emplace<Position>( saved.create(), static_cast<float>(i), 0.0f, 0.0f );
+		}
+		EXODUS_CHECK( RegistrySnapshot::Save<Position>( saved, snapshotPath ) );
+		const std::vector<char> original = ReadFile( snapshotPath );
+		const size_t offset = FindCount( original );
+		EXODUS_CHECK( offset < original.size() );
+		if (offset >= original.size())
+		{
+			return;
+		}
+		// one past the stored entities, a count that wraps the byte size to 0, and the largest
+		for (const uint64_t count : { uint64_t( 101u ), uint64_t( 1u ) << 62, ~uint64_t( 0u ) })
+		{
+			std::vector<char> corrupt = original;
+			std::memcpy( corrupt.data() + offset, &count, sizeof( count ) );
+			WriteFile( snapshotPath, corrupt );
+			Registry loaded;
+			bool result = true;
+			try
+			{
+				result = RegistrySnapshot::Load<Position>( loaded, snapshotPath );
+			}
+			catch (...)
+			{
+				EXODUS_CHECK( !"Load threw on a corrupt count" );
+			}
+			EXODUS_CHECK( !result );
+		}
+		std::remove( snapshotPath );
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestCorruptCount();
+	return EXODUS_TEST_RESULT();
+}
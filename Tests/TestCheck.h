@@ -0,0 +1,44 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#pragma once
+#include <cstdio>
+
+// Checks for the test executables. A failed check is reported with its location and
+// EXODUS_TEST_RESULT() then makes main() return non-zero, so ctest marks the test failed.
+namespace Exodus::Test
+{
+	inline int& Failures() noexcept
+	{
+		static int failures = 0;
+		return failures;
+	}
+}
+
+#define EXODUS_CHECK( condition ) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::fprintf( stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #condition ); \
+			++Exodus::Test::Failures(); \
+		} \
+	} while (false)
+
+#define EXODUS_TEST_RESULT() (Exodus::Test::Failures() == 0 ? 0 : 1)
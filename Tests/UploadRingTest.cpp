@@ -0,0 +1,108 @@
+/******************************************************************************************
+*	CronoGames Game Engine																  *
+*	Copyright  2024 CronoGames <http://www.cronogames.net>								  *
+*																						  *
+*	This file is part of CronoGames Game Engine.										  *
+*																						  *
+*	CronoGames Game Engine is free software: you can redistribute it and/or modify		  *
+*	it under the terms of the GNU General Public License as published by				  *
+*	the Free Software Foundation, either version 3 of the License, or					  *
+*	(at your option) any later version.													  *
+*																						  *
+*	The CronoGames Game Engine is distributed in the hope that it will be useful,		  *
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of						  *
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the						  *
+*	GNU General Public License for more details.										  *
+*																						  *
+*	You should have received a copy of the GNU General Public License					  *
+*	along with The CronoGames Game Engine.  If not, see <http://www.gnu.org/licenses/>.   *
+******************************************************************************************/
+#include "exopch.h"
+#include "D3D/UploadRing.h"
+#include "TestCheck.h"
+
+using namespace Exodus;
+
+namespace
+{
+	constexpr uint64_t invalid = UploadRing::invalidOffset;
+
+	void TestAlignment()
+	{
+		UploadRing ring( 1024u );
+		EXODUS_CHECK( ring.Allocate( 10u, 1u ) == 0u );
+		EXODUS_CHECK( ring.Allocate( 16u, 256u ) == 256u );
+		EXODUS_CHECK( ring.Allocate( 1u, 4u ) == 272u );
+		EXODUS_CHECK( ring.Allocate( 8u, 8u ) == 280u );
+		// the alignment gaps count as used
+		EXODUS_CHECK( ring.GetUsed() == 288u );
+		EXODUS_CHECK( ring.HasUnsubmitted() );
+		// nothing to allocate, or more than the whole buffer
+		EXODUS_CHECK( ring.Allocate( 0u, 1u ) == invalid );
+		EXODUS_CHECK( ring.Allocate( 1025u, 1u ) == invalid );
+		EXODUS_CHECK( UploadRing().Allocate( 1u, 1u ) == invalid );
+	}
+
+	void TestWrapAndReclaim()
+	{
+		UploadRing ring( 1000u );
+		EXODUS_CHECK( ring.GetOldestFenceValue() == 0u );
+		EXODUS_CHECK( ring.Allocate( 600u, 1u ) == 0u );
+		ring.MarkSubmitted( 1u );
+		EXODUS_CHECK( ring.Allocate( 300u, 1u ) == 600u );
+		ring.MarkSubmitted( 2u );
+		EXODUS_CHECK( !ring.HasUnsubmitted() );
+		// nothing new since the last submission, no empty entry
+		ring.MarkSubmitted( 3u );
+		EXODUS_CHECK( ring.GetOldestFenceValue() == 1u );
+		// both submissions are in flight, the ring is full up to the last 100 bytes
+		EXODUS_CHECK( ring.Allocate( 200u, 1u ) == invalid );
+
+		ring.Reclaim( 0u );
+		EXODUS_CHECK( ring.GetUsed() == 900u );
+		ring.Reclaim( 1u );
+		EXODUS_CHECK( ring.GetUsed() == 300u && ring.GetOldestFenceValue() == 2u );
+		// 100 bytes left at the end, the allocation wraps and the tail padding counts as used
+		EXODUS_CHECK( ring.Allocate( 200u, 1u ) == 0u );
+		EXODUS_CHECK( ring.GetUsed() == 600u );
+		// would run into the submission at 600
+		EXODUS_CHECK( ring.Allocate( 500u, 1u ) == invalid );
+		EXODUS_CHECK( ring.Allocate( 400u, 1u ) == 200u );
+		EXODUS_CHECK( ring.GetUsed() == ring.GetCapacity() );
+		EXODUS_CHECK( ring.Allocate( 1u, 1u ) == invalid );
+		ring.MarkSubmitted( 4u );
+
+		// fence 2 frees 600..900, the padding behind it went with the allocations that wrapped
+		ring.Reclaim( 3u );
+		EXODUS_CHECK( ring.GetUsed() == 700u && ring.GetOldestFenceValue() == 4u );
+		// an aligned allocation that doesn't fit before the end wraps as well, into used space
+		EXODUS_CHECK( ring.Allocate( 100u, 512u ) == invalid );
+		// 300 bytes free, but the alignment gap makes it 340
+		EXODUS_CHECK( ring.Allocate( 300u, 64u ) == invalid );
+		EXODUS_CHECK( ring.Allocate( 200u, 64u ) == 640u );
+		ring.MarkSubmitted( 5u );
+		EXODUS_CHECK( ring.GetOldestFenceValue() == 4u );
+		ring.Reclaim( 5u );
+		EXODUS_CHECK( ring.GetUsed() == 0u && ring.GetOldestFenceValue() == 0u );
+		// empty again, it starts over at the front
+		EXODUS_CHECK( ring.Allocate( 1000u, 256u ) == 0u );
+	}
+
+	void TestReset()
+	{
+		UploadRing ring( 256u );
+		EXODUS_CHECK( ring.Allocate( 200u, 1u ) == 0u );
+		ring.MarkSubmitted( 7u );
+		ring.Reset( 512u );
+		EXODUS_CHECK( ring.GetCapacity() == 512u && ring.GetUsed() == 0u && ring.GetOldestFenceValue() == 0u );
+		EXODUS_CHECK( ring.Allocate( 512u, 1u ) == 0u );
+	}
+}
+
+int main()
+{
+	TestAlignment();
+	TestWrapAndReclaim();
+	TestReset();
+	return EXODUS_TEST_RESULT();
+}